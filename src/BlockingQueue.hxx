@@ -0,0 +1,411 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definition of a thread-safe wrapper around a QueueHead, which lets threads
+//  wait for the queue to change state.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added consumers that wait for a node, either by blocking the thread or suspending a coroutine.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+
+//
+//! @class BlockingQueueHead
+//  @brief A thread-safe, optionally bounded, queue of Node items.  Producers that find the queue at its capacity can
+//         either fail (try_push_backward) or wait for space (push_backward_wait), which applies backpressure rather
+//         than letting the queue grow without limit.  Consumers that find the queue empty can either get nothing
+//         (pop_forward), block (pop_forward_wait) or suspend a coroutine (co_await pop_forward_async()).  Producers
+//         and consumers only signal the other side when something is actually waiting.
+//  @tparam T The class of the data to be stored in the queue.
+//  @note This class is thread-safe.  A suspended coroutine is resumed on the thread of the producer that supplies its
+//        node, and none may still be suspended when the queue is destroyed.
+//
+template <class T>
+class BlockingQueueHead
+{
+    public:
+        using size_type = typename QueueHead<T>::size_type;    //!< The type used for node counts.
+
+        //
+        //! @fn BlockingQueueHead(size_type capacity)
+        //  @brief Constructor
+        //  @param capacity - The maximum number of nodes in the queue.
+        //
+        explicit BlockingQueueHead(size_type capacity = QueueHead<T>::unbounded) :
+            queue(capacity),
+            waitingProducers(0),
+            waitingConsumers(0)
+        {}
+
+        //
+        //! @fn ~BlockingQueueHead()
+        //  @brief Default Destructor
+        //
+        ~BlockingQueueHead() = default;
+
+        //
+        //! @fn BlockingQueueHead(const BlockingQueueHead &)
+        //  @brief Disable the ability to copy this class via another BlockingQueueHead.
+        //  @param BlockingQueueHead A reference to a BlockingQueueHead.
+        //
+        BlockingQueueHead(const BlockingQueueHead&) = delete;
+
+        //
+        //! @fn BlockingQueueHead& operator=(BlockingQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param BlockingQueueHead A reference to a BlockingQueueHead.
+        //  @retval BlockingQueueHead A reference to a BlockingQueueHead.
+        //
+        BlockingQueueHead&
+        operator=(const BlockingQueueHead&) = delete;
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no nodes in the queue (the queue is empty).
+        //  @return true - There are no nodes currently in the queue.
+        //  @return false - There are is at least one node currently in the queue.
+        //
+        bool
+        isEmpty()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            return queue.isEmpty();
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in the queue.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            return queue.size();
+        }
+
+        //
+        //! @fn size_type capacity()
+        //  @brief Return the maximum number of nodes allowed in the queue.
+        //  @return The capacity of the queue.
+        //
+        size_type
+        capacity()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            return queue.capacity();
+        }
+
+        //
+        //! @fn bool try_push_backward(Node<T>* node)
+        //  @brief Add the supplied node to the tail of the queue, unless the queue is at its capacity.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //  @return true - The node was added to the queue.
+        //  @return false - The queue is full, the node was not added.
+        //
+        bool
+        try_push_backward(Node<T>* node)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            if (suspended.isEmpty() && queue.isFull())
+            {
+                return false;
+            }
+            deliver(node, guard);
+            return true;
+        }
+
+        //
+        //! @fn void push_backward_wait(Node<T>* node)
+        //  @brief Add the supplied node to the tail of the queue, waiting for space if the queue is at its capacity.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //
+        void
+        push_backward_wait(Node<T>* node)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (suspended.isEmpty() && queue.isFull())
+            {
+                waitingProducers++;
+                notFull.wait(guard);
+                waitingProducers--;
+            }
+            deliver(node, guard);
+        }
+
+        //
+        //! @fn bool push_backward_wait_for(Node<T>* node, const std::chrono::duration<Rep, Period>& timeout)
+        //  @brief Add the supplied node to the tail of the queue, waiting up to the timeout for space if the queue is
+        //         at its capacity.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //  @param timeout - The maximum time to wait for space.
+        //  @return true - The node was added to the queue.
+        //  @return false - The queue remained full for the entire timeout, the node was not added.
+        //
+        template <class Rep, class Period>
+        bool
+        push_backward_wait_for(Node<T>* node, const std::chrono::duration<Rep, Period>& timeout)
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (suspended.isEmpty() && queue.isFull())
+            {
+                waitingProducers++;
+
+                std::cv_status status = notFull.wait_until(guard, deadline);
+
+                waitingProducers--;
+                if ((status == std::cv_status::timeout) && suspended.isEmpty() && queue.isFull())
+                {
+                    return false;
+                }
+            }
+            deliver(node, guard);
+            return true;
+        }
+
+        //
+        //! @fn Node<T>* pop_forward()
+        //  @brief Remove the first node in the queue, waking a producer waiting for space.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        Node<T>*
+        pop_forward()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            return take(guard);
+        }
+
+        //
+        //! @fn Node<T>* pop_forward_wait()
+        //  @brief Remove the first node in the queue, waiting for one if the queue is empty.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //
+        Node<T>*
+        pop_forward_wait()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (queue.isEmpty())
+            {
+                waitingConsumers++;
+                notEmpty.wait(guard);
+                waitingConsumers--;
+            }
+            return take(guard);
+        }
+
+        //
+        //! @fn Node<T>* pop_forward_wait_for(const std::chrono::duration<Rep, Period>& timeout)
+        //  @brief Remove the first node in the queue, waiting up to the timeout for one if the queue is empty.
+        //  @param timeout - The maximum time to wait for a node.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue remained empty for the entire timeout.
+        //
+        template <class Rep, class Period>
+        Node<T>*
+        pop_forward_wait_for(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (queue.isEmpty())
+            {
+                waitingConsumers++;
+
+                std::cv_status status = notEmpty.wait_until(guard, deadline);
+
+                waitingConsumers--;
+                if ((status == std::cv_status::timeout) && queue.isEmpty())
+                {
+                    return nullptr;
+                }
+            }
+            return take(guard);
+        }
+
+        //
+        //! @class PopAwaiter
+        //  @brief The awaitable returned by pop_forward_async.  The result of co_await is the node removed from the
+        //         beginning of the queue.
+        //
+        class PopAwaiter
+        {
+            public:
+
+                //
+                //! @fn PopAwaiter(BlockingQueueHead& queue)
+                //  @brief Constructor
+                //  @param queue - The queue the node is to be removed from.
+                //
+                explicit PopAwaiter(BlockingQueueHead& queue) :
+                    owner(queue),
+                    waiter(std::in_place, this),
+                    result(nullptr),
+                    handle()
+                {}
+
+                //
+                //! @fn bool await_ready()
+                //  @brief Remove the first node in the queue, if there is one, without suspending.
+                //  @return true - A node was removed, so the coroutine does not need to suspend.
+                //  @return false - The queue is empty.
+                //
+                bool
+                await_ready()
+                {
+                    result = owner.pop_forward();
+                    return result != nullptr;
+                }
+
+                //
+                //! @fn bool await_suspend(std::coroutine_handle<> coroutine)
+                //  @brief Suspend the coroutine until a producer supplies a node, unless one arrived in the meantime.
+                //  @param coroutine - The coroutine awaiting a node.
+                //  @return true - The coroutine is suspended.
+                //  @return false - A node was removed, so the coroutine continues.
+                //
+                bool
+                await_suspend(std::coroutine_handle<> coroutine)
+                {
+                    std::unique_lock<std::mutex> guard(owner.lock);
+
+                    if (owner.queue.isEmpty())
+                    {
+                        handle = coroutine;
+                        owner.suspended.push_backward(&waiter);
+                        return true;
+                    }
+                    result = owner.take(guard);
+                    return false;
+                }
+
+                //
+                //! @fn Node<T>* await_resume()
+                //  @brief Return the node removed from the queue.
+                //  @return The address of the node removed from the beginning of the queue.
+                //
+                Node<T>*
+                await_resume()
+                {
+                    return result;
+                }
+
+            private:
+                friend class BlockingQueueHead;
+
+                BlockingQueueHead& owner;           //!< The queue the node is removed from.
+                Node<PopAwaiter*> waiter;           //!< Links this awaiter into the list of suspended coroutines.
+                Node<T>* result;                    //!< The node removed from the queue.
+                std::coroutine_handle<> handle;     //!< The suspended coroutine.
+        };
+
+        //
+        //! @fn PopAwaiter pop_forward_async()
+        //  @brief Return an awaitable that removes the first node in the queue, suspending the awaiting coroutine
+        //         while the queue is empty.
+        //  @return An awaitable whose co_await result is the node removed.
+        //
+        PopAwaiter
+        pop_forward_async()
+        {
+            return PopAwaiter(*this);
+        }
+
+    private:
+
+        //
+        //! @fn void deliver(Node<T>* node, std::unique_lock<std::mutex>& guard)
+        //  @brief Hand the supplied node to a suspended coroutine, or add it to the tail of the queue and wake a
+        //         waiting consumer.  The lock is released before anything is woken or resumed.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //  @param guard - The held lock.
+        //
+        void
+        deliver(Node<T>* node, std::unique_lock<std::mutex>& guard)
+        {
+            Node<PopAwaiter*>* waiter = suspended.pop_forward();
+
+            if (waiter != nullptr)
+            {
+                PopAwaiter* awaiter = waiter->data();
+
+                awaiter->result = node;
+                guard.unlock();
+                awaiter->handle.resume();
+                return;
+            }
+
+            bool wake = (waitingConsumers > 0);
+
+            queue.push_backward(node);
+            guard.unlock();
+            if (wake)
+            {
+                notEmpty.notify_one();
+            }
+        }
+
+        //
+        //! @fn Node<T>* take(std::unique_lock<std::mutex>& guard)
+        //  @brief Remove the first node in the queue, waking a producer waiting for space.  The lock is released
+        //         before the producer is woken.
+        //  @param guard - The held lock.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        Node<T>*
+        take(std::unique_lock<std::mutex>& guard)
+        {
+            Node<T>* node = queue.pop_forward();
+            bool wake = (node != nullptr) && (waitingProducers > 0);
+
+            guard.unlock();
+            if (wake)
+            {
+                notFull.notify_one();
+            }
+            return node;
+        }
+
+        std::mutex lock;                    //!< Protects the remainder of the members.
+        std::condition_variable notFull;    //!< Signalled when a node is removed while producers are waiting.
+        std::condition_variable notEmpty;   //!< Signalled when a node is added while consumers are waiting.
+        QueueHead<T> queue;                 //!< The queue of nodes.
+        QueueHead<PopAwaiter*> suspended;   //!< The coroutines waiting for a node.
+        size_type waitingProducers;         //!< The number of producers waiting for space.
+        size_type waitingConsumers;         //!< The number of consumers waiting for a node.
+};
@@ -0,0 +1,757 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definition of a double-ended queue that stores its data in doubly-linked,
+//  cache-line aligned chunks, rather than one Node per item.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Allocate the chunks with their own alignment, which is more than a cache line for an over-aligned T.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//
+//! @class ChunkedQueueHead
+//  @brief A header for a queue that stores its data in chunks of ChunkSize items (an unrolled list).  The chunks are
+//         linked forward and backward like the nodes of a QueueHead, but the two links, and the allocation, are shared
+//         by every item in the chunk, and a traversal reads consecutive items from the same cache lines.  The data can
+//         be pushed and popped at either end and traversed in either direction, as with a QueueHead, but the queue
+//         owns its data: it is copied or moved in, and moved out when popped.
+//  @tparam T Type of the data to be stored in the queue.
+//  @tparam ChunkSize The number of items in each chunk.
+//  @note This class is not thread-safe.  Pushing or popping at one end does not invalidate iterators to the other items.
+//        One empty chunk is kept for reuse, so a queue that repeatedly crosses a chunk boundary does not allocate.
+//
+template <class T, std::size_t ChunkSize = 64>
+class ChunkedQueueHead
+{
+    static_assert(ChunkSize > 0, "A chunk must hold at least one item");
+
+    struct Chunk;
+
+    public:
+        using size_type = std::size_t;          //!< The type used for item counts.
+        using value_type = T;                   //!< The type of the data.
+        using reference = T&;                   //!< A reference to an item.
+        using const_reference = const T&;       //!< A constant reference to an item.
+
+        static constexpr std::size_t cacheLine = 64;    //!< The minimum alignment of each chunk.
+
+        //
+        //! @class Iterator
+        //  @brief A bidirectional iterator over the items in the queue.  Incrementing past the last item reaches end().
+        //  @tparam Const true - The data is accessed through a constant reference.
+        //
+        template <bool Const>
+        class Iterator
+        {
+            public:
+                using iterator_concept = std::bidirectional_iterator_tag;
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename std::conditional<Const, const T*, T*>::type;
+                using reference = typename std::conditional<Const, const T&, T&>::type;
+
+                //
+                //! @fn Iterator()
+                //  @brief Default Constructor, for an iterator not associated with any queue.
+                //
+                Iterator() = default;
+
+                //
+                //! @fn Iterator(const ChunkedQueueHead* header, Chunk* chunk, std::size_t index)
+                //  @brief Constructor
+                //  @param header - The queue being iterated over.
+                //  @param chunk - The chunk holding the item, nullptr for end().
+                //  @param index - The position of the item in the chunk.
+                //
+                Iterator(const ChunkedQueueHead* header, Chunk* chunk, std::size_t index) :
+                    owner(header),
+                    current(chunk),
+                    position(index)
+                {}
+
+                //
+                //! @fn Iterator(const Iterator<false>& other)
+                //  @brief Convert an iterator to a constant iterator.
+                //  @param other - The iterator to be converted.
+                //
+                template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+                Iterator(const Iterator<OtherConst>& other) :
+                    owner(other.owner),
+                    current(other.current),
+                    position(other.position)
+                {}
+
+                //
+                //! @fn reference operator*()
+                //  @brief Return a reference to the item.
+                //  @return A reference to the item.
+                //
+                reference
+                operator*() const
+                {
+                    return *current->item(position);
+                }
+
+                //
+                //! @fn pointer operator->()
+                //  @brief Return the address of the item.
+                //  @return A pointer to the item.
+                //
+                pointer
+                operator->() const
+                {
+                    return current->item(position);
+                }
+
+                //
+                //! @fn Iterator& operator++()
+                //  @brief Move to the next item.
+                //  @return This iterator.
+                //
+                Iterator&
+                operator++()
+                {
+                    if (++position == current->last)
+                    {
+                        current = current->flink;
+                        position = (current == nullptr) ? 0 : current->first;
+                    }
+                    return *this;
+                }
+
+                //
+                //! @fn Iterator operator++(int)
+                //  @brief Move to the next item.
+                //  @return The iterator before it was moved.
+                //
+                Iterator
+                operator++(int)
+                {
+                    Iterator previous = *this;
+
+                    ++*this;
+                    return previous;
+                }
+
+                //
+                //! @fn Iterator& operator--()
+                //  @brief Move to the previous item.
+                //  @return This iterator.
+                //
+                Iterator&
+                operator--()
+                {
+                    if (current == nullptr)
+                    {
+                        current = owner->tail;
+                        position = current->last - 1;
+                    }
+                    else if (position == current->first)
+                    {
+                        current = current->blink;
+                        position = current->last - 1;
+                    }
+                    else
+                    {
+                        position--;
+                    }
+                    return *this;
+                }
+
+                //
+                //! @fn Iterator operator--(int)
+                //  @brief Move to the previous item.
+                //  @return The iterator before it was moved.
+                //
+                Iterator
+                operator--(int)
+                {
+                    Iterator previous = *this;
+
+                    --*this;
+                    return previous;
+                }
+
+                //
+                //! @fn bool operator==(const Iterator& other)
+                //  @brief Return a boolean if both iterators refer to the same item.
+                //  @retval true - The iterators refer to the same item.
+                //  @retval false - The iterators refer to different items.
+                //
+                bool
+                operator==(const Iterator& other) const
+                {
+                    return (current == other.current) && (position == other.position);
+                }
+
+            private:
+                template <bool OtherConst>
+                friend class Iterator;
+
+                const ChunkedQueueHead* owner = nullptr;    //!< The queue being iterated over.
+                Chunk* current = nullptr;                   //!< The chunk holding the item, nullptr for end().
+                std::size_t position = 0;                   //!< The position of the item in the chunk.
+        };
+
+        using iterator = Iterator<false>;                                       //!< Iterator over the data.
+        using const_iterator = Iterator<true>;                                  //!< Constant iterator over the data.
+        using reverse_iterator = std::reverse_iterator<iterator>;               //!< Reverse iterator over the data.
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;   //!< Constant reverse iterator.
+
+        //
+        //! @fn ChunkedQueueHead()
+        //  @brief Default Constructor
+        //
+        explicit ChunkedQueueHead() = default;
+
+        //
+        //! @fn ~ChunkedQueueHead()
+        //  @brief Destructor, which destroys the items still in the queue and frees the chunks.
+        //
+        ~ChunkedQueueHead()
+        {
+            clear();
+            freeChunk(spare);
+        }
+
+        //
+        //! @fn ChunkedQueueHead(const ChunkedQueueHead &)
+        //  @brief Disable the ability to copy this class via another ChunkedQueueHead.
+        //  @param ChunkedQueueHead A reference to a ChunkedQueueHead.
+        //
+        ChunkedQueueHead(const ChunkedQueueHead&) = delete;
+
+        //
+        //! @fn ChunkedQueueHead& operator=(ChunkedQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param ChunkedQueueHead A reference to a ChunkedQueueHead.
+        //  @retval ChunkedQueueHead A reference to a ChunkedQueueHead.
+        //
+        ChunkedQueueHead&
+        operator=(const ChunkedQueueHead&) = delete;
+
+        //
+        //! @fn std::size_t chunkBytes()
+        //  @brief Return the size of a chunk, including its links and padding.
+        //  @return The number of bytes allocated for each chunk.
+        //
+        static constexpr std::size_t
+        chunkBytes()
+        {
+            return sizeof(Chunk);
+        }
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no items in the queue (the queue is empty).
+        //  @return true - There are no items currently in the queue.
+        //  @return false - There are is at least one item currently in the queue.
+        //
+        bool
+        isEmpty() const
+        {
+            return itemCount == 0;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of items in the queue.
+        //  @return The number of items currently in the queue.
+        //
+        size_type
+        size() const
+        {
+            return itemCount;
+        }
+
+        //
+        //! @fn std::size_t chunkCount()
+        //  @brief Return the number of chunks holding items, not counting the spare.
+        //  @return The number of chunks in use.
+        //
+        std::size_t
+        chunkCount() const
+        {
+            return chunksInUse;
+        }
+
+        //
+        //! @fn T& front()
+        //  @brief Return a reference to the first item.  The queue must not be empty.
+        //  @return A reference to the first item.
+        //
+        T&
+        front()
+        {
+            return *head->item(head->first);
+        }
+
+        //
+        //! @fn T& back()
+        //  @brief Return a reference to the last item.  The queue must not be empty.
+        //  @return A reference to the last item.
+        //
+        T&
+        back()
+        {
+            return *tail->item(tail->last - 1);
+        }
+
+        //
+        //! @fn void push_forward(T data)
+        //  @brief Add an item to the front of the queue.
+        //  @param data - The item to be added.
+        //
+        void
+        push_forward(T data)
+        {
+            emplace_forward(std::move(data));
+        }
+
+        //
+        //! @fn void push_backward(T data)
+        //  @brief Add an item to the tail of the queue.
+        //  @param data - The item to be added.
+        //
+        void
+        push_backward(T data)
+        {
+            emplace_backward(std::move(data));
+        }
+
+        //
+        //! @fn T& emplace_forward(Args&&... args)
+        //  @brief Construct an item in place at the front of the queue, starting a new chunk if the first is full.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return A reference to the new item.
+        //
+        template <class... Args>
+        T&
+        emplace_forward(Args&&... args)
+        {
+            if ((head == nullptr) || (head->first == 0))
+            {
+                Chunk* chunk = newChunk(ChunkSize);
+                T* data = construct(chunk, ChunkSize - 1, std::forward<Args>(args)...);
+
+                chunk->first = ChunkSize - 1;
+                chunk->flink = head;
+                if (head == nullptr)
+                {
+                    tail = chunk;
+                }
+                else
+                {
+                    head->blink = chunk;
+                }
+                head = chunk;
+                itemCount++;
+                return *data;
+            }
+
+            T* data = construct(head, head->first - 1, std::forward<Args>(args)...);
+
+            head->first--;
+            itemCount++;
+            return *data;
+        }
+
+        //
+        //! @fn T& emplace_backward(Args&&... args)
+        //  @brief Construct an item in place at the tail of the queue, starting a new chunk if the last is full.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return A reference to the new item.
+        //
+        template <class... Args>
+        T&
+        emplace_backward(Args&&... args)
+        {
+            if ((tail == nullptr) || (tail->last == ChunkSize))
+            {
+                Chunk* chunk = newChunk(0);
+                T* data = construct(chunk, 0, std::forward<Args>(args)...);
+
+                chunk->last = 1;
+                chunk->blink = tail;
+                if (tail == nullptr)
+                {
+                    head = chunk;
+                }
+                else
+                {
+                    tail->flink = chunk;
+                }
+                tail = chunk;
+                itemCount++;
+                return *data;
+            }
+
+            T* data = construct(tail, tail->last, std::forward<Args>(args)...);
+
+            tail->last++;
+            itemCount++;
+            return *data;
+        }
+
+        //
+        //! @fn bool pop_forward(T& data)
+        //  @brief Remove the first item in the queue, moving it to the caller.
+        //  @param data - Receives the item removed.
+        //  @return true - An item was removed and returned.
+        //  @return false - The queue is empty.
+        //
+        bool
+        pop_forward(T& data)
+        {
+            if (head == nullptr)
+            {
+                return false;
+            }
+
+            T* first = head->item(head->first);
+
+            data = std::move(*first);
+            first->~T();
+            itemCount--;
+            if (++head->first == head->last)
+            {
+                Chunk* chunk = head;
+
+                head = chunk->flink;
+                if (head == nullptr)
+                {
+                    tail = nullptr;
+                }
+                else
+                {
+                    head->blink = nullptr;
+                }
+                retire(chunk);
+            }
+            return true;
+        }
+
+        //
+        //! @fn bool pop_backward(T& data)
+        //  @brief Remove the last item in the queue, moving it to the caller.
+        //  @param data - Receives the item removed.
+        //  @return true - An item was removed and returned.
+        //  @return false - The queue is empty.
+        //
+        bool
+        pop_backward(T& data)
+        {
+            if (tail == nullptr)
+            {
+                return false;
+            }
+
+            T* last = tail->item(tail->last - 1);
+
+            data = std::move(*last);
+            last->~T();
+            itemCount--;
+            if (--tail->last == tail->first)
+            {
+                Chunk* chunk = tail;
+
+                tail = chunk->blink;
+                if (tail == nullptr)
+                {
+                    head = nullptr;
+                }
+                else
+                {
+                    tail->flink = nullptr;
+                }
+                retire(chunk);
+            }
+            return true;
+        }
+
+        //
+        //! @fn void clear()
+        //  @brief Destroy every item in the queue and free the chunks, except the spare.
+        //
+        void
+        clear()
+        {
+            while (head != nullptr)
+            {
+                Chunk* chunk = head;
+
+                for (std::size_t ii = chunk->first; ii < chunk->last; ii++)
+                {
+                    chunk->item(ii)->~T();
+                }
+                head = chunk->flink;
+                chunksInUse--;
+                freeChunk(chunk);
+            }
+            tail = nullptr;
+            itemCount = 0;
+        }
+
+        //
+        //! @fn iterator begin()
+        //  @brief Return an iterator to the first item in the queue.
+        //  @return An iterator to the first item (or end() if the queue is empty).
+        //
+        iterator
+        begin()
+        {
+            return iterator(this, head, (head == nullptr) ? 0 : head->first);
+        }
+
+        //
+        //! @fn iterator end()
+        //  @brief Return an iterator that follows the last item in the queue.
+        //  @return An iterator past the last item.
+        //
+        iterator
+        end()
+        {
+            return iterator(this, nullptr, 0);
+        }
+
+        //
+        //! @fn const_iterator begin() const
+        //  @brief Return a constant iterator to the first item in the queue.
+        //  @return A constant iterator to the first item (or end() if the queue is empty).
+        //
+        const_iterator
+        begin() const
+        {
+            return const_iterator(this, head, (head == nullptr) ? 0 : head->first);
+        }
+
+        //
+        //! @fn const_iterator end() const
+        //  @brief Return a constant iterator that follows the last item in the queue.
+        //  @return A constant iterator past the last item.
+        //
+        const_iterator
+        end() const
+        {
+            return const_iterator(this, nullptr, 0);
+        }
+
+        //
+        //! @fn const_iterator cbegin() const
+        //  @brief Return a constant iterator to the first item in the queue.
+        //  @return A constant iterator to the first item (or end() if the queue is empty).
+        //
+        const_iterator
+        cbegin() const
+        {
+            return begin();
+        }
+
+        //
+        //! @fn const_iterator cend() const
+        //  @brief Return a constant iterator that follows the last item in the queue.
+        //  @return A constant iterator past the last item.
+        //
+        const_iterator
+        cend() const
+        {
+            return end();
+        }
+
+        //
+        //! @fn reverse_iterator rbegin()
+        //  @brief Return a reverse iterator to the last item in the queue.
+        //  @return A reverse iterator to the last item.
+        //
+        reverse_iterator
+        rbegin()
+        {
+            return reverse_iterator(end());
+        }
+
+        //
+        //! @fn reverse_iterator rend()
+        //  @brief Return a reverse iterator that precedes the first item in the queue.
+        //  @return A reverse iterator before the first item.
+        //
+        reverse_iterator
+        rend()
+        {
+            return reverse_iterator(begin());
+        }
+
+        //
+        //! @fn const_reverse_iterator rbegin() const
+        //  @brief Return a constant reverse iterator to the last item in the queue.
+        //  @return A constant reverse iterator to the last item.
+        //
+        const_reverse_iterator
+        rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+
+        //
+        //! @fn const_reverse_iterator rend() const
+        //  @brief Return a constant reverse iterator that precedes the first item in the queue.
+        //  @return A constant reverse iterator before the first item.
+        //
+        const_reverse_iterator
+        rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+
+    private:
+
+        //
+        //! @struct Chunk
+        //  @brief A block of items, starting on a cache line.  The items in use are those from first up to, but not
+        //         including, last.
+        //
+        struct alignas(cacheLine) Chunk
+        {
+            //
+            //! @fn T* item(std::size_t index)
+            //  @brief Return the address of an item in the chunk.
+            //  @param index - The position of the item.
+            //  @return The address of the item.
+            //
+            T*
+            item(std::size_t index)
+            {
+                return std::launder(reinterpret_cast<T*>(storage) + index);
+            }
+
+            Chunk* flink;                                   //!< The next chunk, nullptr for the last.
+            Chunk* blink;                                   //!< The previous chunk, nullptr for the first.
+            std::uint32_t first;                            //!< The position of the first item in use.
+            std::uint32_t last;                             //!< The position after the last item in use.
+            alignas(T) unsigned char storage[ChunkSize * sizeof(T)];   //!< The items.
+        };
+
+        //
+        //! @fn T* construct(Chunk* chunk, std::size_t index, Args&&... args)
+        //  @brief Construct an item in a chunk.  If the chunk is not yet linked into the queue and the constructor
+        //         throws, the chunk is retired.
+        //  @param chunk - The chunk to hold the item.
+        //  @param index - The position of the item in the chunk.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return The address of the item.
+        //
+        template <class... Args>
+        T*
+        construct(Chunk* chunk, std::size_t index, Args&&... args)
+        {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+            {
+                return ::new (static_cast<void*>(chunk->item(index))) T(std::forward<Args>(args)...);
+            }
+            else
+            {
+                try
+                {
+                    return ::new (static_cast<void*>(chunk->item(index))) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    if ((chunk != head) && (chunk != tail))
+                    {
+                        retire(chunk);
+                    }
+                    throw;
+                }
+            }
+        }
+
+        //
+        //! @fn Chunk* newChunk(std::size_t position)
+        //  @brief Return the spare chunk, or allocate one, with no items in use.
+        //  @param position - The position of the first item to be added.
+        //  @return The address of the chunk.
+        //
+        Chunk*
+        newChunk(std::size_t position)
+        {
+            Chunk* chunk = spare;
+
+            if (chunk == nullptr)
+            {
+                chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk), std::align_val_t(alignof(Chunk))));
+            }
+            spare = nullptr;
+            chunk->flink = nullptr;
+            chunk->blink = nullptr;
+            chunk->first = static_cast<std::uint32_t>(position);
+            chunk->last = static_cast<std::uint32_t>(position);
+            chunksInUse++;
+            return chunk;
+        }
+
+        //
+        //! @fn void retire(Chunk* chunk)
+        //  @brief Keep a chunk that no longer holds any items as the spare, or free it if there already is one.
+        //  @param chunk - The chunk, already unlinked from the queue.
+        //
+        void
+        retire(Chunk* chunk)
+        {
+            chunksInUse--;
+            if (spare == nullptr)
+            {
+                spare = chunk;
+            }
+            else
+            {
+                freeChunk(chunk);
+            }
+        }
+
+        //
+        //! @fn void freeChunk(Chunk* chunk)
+        //  @brief Free a chunk.
+        //  @param chunk - The chunk, or nullptr.
+        //
+        static void
+        freeChunk(Chunk* chunk)
+        {
+            if (chunk != nullptr)
+            {
+                ::operator delete(chunk, std::align_val_t(alignof(Chunk)));
+            }
+        }
+
+        Chunk* head = nullptr;                      //!< The first chunk, nullptr if the queue is empty.
+        Chunk* tail = nullptr;                      //!< The last chunk, nullptr if the queue is empty.
+        Chunk* spare = nullptr;                     //!< An empty chunk kept for reuse.
+        size_type itemCount = 0;                    //!< The number of items in the queue.
+        std::size_t chunksInUse = 0;                //!< The number of chunks holding items.
+};
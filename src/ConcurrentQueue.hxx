@@ -0,0 +1,440 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definitions to support a multi-producer/multi-consumer queue of the same
+//  Node items used by the QueueHead, with lock-free enqueue and dequeue and synchronous reclamation of dequeued nodes.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added the chain push, which links a whole batch with a single CAS.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Documented that dequeued nodes are reclaimed synchronously, so pop_forward can wait on another thread.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <atomic>
+#include <thread>
+
+//
+//! @class HazardPointers
+//  @brief A process wide set of hazard pointers.  Each thread gets a record with a small number of slots, which it
+//         uses to announce the nodes it is about to dereference.  A node may not be handed back to its owner until no
+//         other thread has it announced.
+//  @note This class is thread-safe.
+//
+class HazardPointers
+{
+    public:
+        static constexpr int slotsPerThread = 2;    //!< Number of nodes a thread can protect at one time.
+
+        //
+        //! @fn void protect(int index, const void* pointer)
+        //  @brief Announce that the calling thread is about to dereference the supplied pointer.
+        //  @param index - The slot, in the calling thread's record, to use for the announcement.
+        //  @param pointer - The pointer being protected.
+        //
+        static void
+        protect(int index, const void* pointer)
+        {
+            self()->slot[index].store(pointer);
+        }
+
+        //
+        //! @fn void clear()
+        //  @brief Remove all the calling thread's announcements.
+        //
+        static void
+        clear()
+        {
+            Record* record = self();
+
+            for (int ii = 0; ii < slotsPerThread; ii++)
+            {
+                record->slot[ii].store(nullptr, std::memory_order_release);
+            }
+        }
+
+        //
+        //! @fn void waitUntilUnprotected(const void* pointer)
+        //  @brief Wait until no other thread has the supplied pointer announced.  The calling thread must have
+        //         already cleared its own announcements.  This blocks for as long as another thread keeps the
+        //         pointer announced, including while that thread is preempted.
+        //  @param pointer - The pointer no longer reachable from the queue.
+        //
+        static void
+        waitUntilUnprotected(const void* pointer)
+        {
+            for (Record* record = records.load(std::memory_order_acquire);
+                 record != nullptr;
+                 record = record->next.load(std::memory_order_acquire))
+            {
+                for (int ii = 0; ii < slotsPerThread; ii++)
+                {
+                    while (record->slot[ii].load() == pointer)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+    private:
+
+        //
+        //! @struct Record
+        //  @brief The hazard pointers for a single thread.  Records are never freed, they are reused once the thread
+        //         owning it exits.
+        //
+        struct Record
+        {
+            std::atomic<Record*> next{nullptr};                 //!< The next record in the list of records.
+            std::atomic<bool> active{false};                    //!< Indicates the record is owned by a thread.
+            std::atomic<const void*> slot[slotsPerThread]{};    //!< The announced pointers.
+        };
+
+        //
+        //! @struct Owner
+        //  @brief Ties a Record to the lifetime of a thread.
+        //
+        struct Owner
+        {
+            Owner() :
+                record(acquire())
+            {}
+
+            ~Owner()
+            {
+                for (int ii = 0; ii < slotsPerThread; ii++)
+                {
+                    record->slot[ii].store(nullptr);
+                }
+                record->active.store(false, std::memory_order_release);
+            }
+
+            Record* record;                                     //!< The record owned by the thread.
+        };
+
+        //
+        //! @fn Record* acquire()
+        //  @brief Reuse an inactive record, or add a new one to the list of records.
+        //  @return The record now owned by the calling thread.
+        //
+        static Record*
+        acquire()
+        {
+            for (Record* record = records.load(std::memory_order_acquire);
+                 record != nullptr;
+                 record = record->next.load(std::memory_order_acquire))
+            {
+                bool expected = false;
+
+                if (!record->active.load(std::memory_order_relaxed) &&
+                    record->active.compare_exchange_strong(expected, true))
+                {
+                    return record;
+                }
+            }
+
+            Record* record = new Record;
+            Record* first = records.load(std::memory_order_relaxed);
+
+            record->active.store(true, std::memory_order_relaxed);
+            do
+            {
+                record->next.store(first, std::memory_order_relaxed);
+            } while (!records.compare_exchange_weak(first, record, std::memory_order_release));
+            return record;
+        }
+
+        //
+        //! @fn Record* self()
+        //  @brief Return the record owned by the calling thread.
+        //  @return The record of the calling thread.
+        //
+        static Record*
+        self()
+        {
+            thread_local Owner owner;
+
+            return owner.record;
+        }
+
+        static inline std::atomic<Record*> records{nullptr};    //!< All records ever allocated.
+};
+
+//
+//! @class ConcurrentQueueHead
+//  @brief A header for a multi-producer/multi-consumer queue of Node items.  This is a Michael-Scott queue where the
+//         caller owns the nodes, so no memory is allocated to enqueue or dequeue.  An internal stub node takes the
+//         place of the dummy node when the queue would otherwise be drained, and hazard pointers keep a dequeued node
+//         from being handed back to its owner while another thread may still be looking at it.
+//
+//         Enqueue and dequeue are lock-free: neither takes a lock, and a stalled thread cannot stop other producers
+//         or consumers from making progress.  Reclamation is synchronous, not lock-free: once pop_forward has
+//         unlinked a node, it waits until no other thread has that node announced before returning it.  Announcements
+//         last a few instructions, but a thread preempted while holding one delays the consumer that popped that node
+//         (and only that consumer) until it runs again.  The trade-off is that a node is entirely the caller's as soon
+//         as pop_forward returns it, to reuse, push elsewhere or delete, without a deferred retire step; a non-blocking
+//         scheme would have to keep protected nodes back and return them later, out of order.
+//  @tparam T The class of the data to be stored in the queue.
+//  @note This class is thread-safe.  Nodes are only linked forward, so backward() is not meaningful while a node is in
+//        this queue.
+//
+template <class T>
+class ConcurrentQueueHead
+{
+    public:
+
+        //
+        //! @fn ConcurrentQueueHead()
+        //  @brief Default Constructor
+        //
+        explicit ConcurrentQueueHead() :
+            head(&stub),
+            tail(&stub),
+            stubLinked(true)
+        {
+            stub.flink = nullptr;
+        }
+
+        //
+        //! @fn ~ConcurrentQueueHead()
+        //  @brief Default Destructor
+        //
+        ~ConcurrentQueueHead() = default;
+
+        //
+        //! @fn ConcurrentQueueHead(const ConcurrentQueueHead &)
+        //  @brief Disable the ability to copy this class via another ConcurrentQueueHead.
+        //  @param ConcurrentQueueHead A reference to a ConcurrentQueueHead.
+        //
+        ConcurrentQueueHead(const ConcurrentQueueHead&) = delete;
+
+        //
+        //! @fn ConcurrentQueueHead& operator=(ConcurrentQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param ConcurrentQueueHead A reference to a ConcurrentQueueHead.
+        //  @retval ConcurrentQueueHead A reference to a ConcurrentQueueHead.
+        //
+        ConcurrentQueueHead&
+        operator=(const ConcurrentQueueHead&) = delete;
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no nodes in the queue (the queue is empty).  With other threads
+        //         active, this is only a snapshot.
+        //  @return true - There are no nodes currently in the queue.
+        //  @return false - There are is at least one node currently in the queue.
+        //
+        bool
+        isEmpty()
+        {
+            return (head.load() == &stub) && (link(&stub).load(std::memory_order_acquire) == nullptr);
+        }
+
+        //
+        //! @fn void push_backward(Node<T>* node)
+        //  @brief Add the supplied node to the tail of the queue.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //
+        void
+        push_backward(Node<T>* node)
+        {
+            enqueue(node, node);
+            HazardPointers::clear();
+        }
+
+        //
+        //! @fn void push_backward(Node<T>* first, Node<T>* last)
+        //  @brief Add a chain of nodes to the tail of the queue with a single CAS.  The nodes from first to last must
+        //         already be linked forward to each other, such as a ring built with Node::insque, and must not be in
+        //         a queue.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //
+        void
+        push_backward(Node<T>* first, Node<T>* last)
+        {
+            enqueue(first, last);
+            HazardPointers::clear();
+        }
+
+        //
+        //! @fn Node<T>* pop_forward()
+        //  @brief Remove the first node in the queue.  The node is only returned once no other thread can still be
+        //         referencing it, so the caller is free to reuse or delete it.  The removal is lock-free, but the wait
+        //         for other threads to drop their hazard pointers to the node blocks while one of them is stalled.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        Node<T>*
+        pop_forward()
+        {
+            while (true)
+            {
+                Node<T>* first = protect(0, head);
+                Node<T>* last = tail.load();
+                Node<T>* next = link(first).load(std::memory_order_acquire);
+
+                HazardPointers::protect(1, next);
+                if (head.load() != first)
+                {
+                    continue;
+                }
+                if (first == last)
+                {
+                    if (next == nullptr)
+                    {
+                        if (first == &stub)
+                        {
+                            HazardPointers::clear();
+                            return nullptr;
+                        }
+
+                        //
+                        // The only node left has data in it.  Put the stub behind it so it can be removed.
+                        //
+                        requeueStub();
+                    }
+                    else
+                    {
+                        tail.compare_exchange_strong(last, next);
+                    }
+                    continue;
+                }
+                if ((next != nullptr) && head.compare_exchange_strong(first, next))
+                {
+                    HazardPointers::clear();
+                    HazardPointers::waitUntilUnprotected(first);
+                    if (first == &stub)
+                    {
+                        stubLinked.store(false, std::memory_order_release);
+                        continue;
+                    }
+                    first->flink = first;
+                    first->blink = first;
+                    return first;
+                }
+            }
+        }
+
+    private:
+
+        //
+        //! @fn std::atomic_ref<Node<T>*> link(Node<T>* node)
+        //  @brief Return an atomic view of the forward link of the supplied node.
+        //  @param node - The node whose forward link is being accessed.
+        //  @return An atomic reference to the forward link.
+        //
+        static std::atomic_ref<Node<T>*>
+        link(Node<T>* node)
+        {
+            return std::atomic_ref<Node<T>*>(node->flink);
+        }
+
+        //
+        //! @fn Node<T>* protect(int index, std::atomic<Node<T>*>& source)
+        //  @brief Load a pointer and announce it, repeating until the announcement is known to have been made while
+        //         the pointer was still current.
+        //  @param index - The hazard pointer slot to use.
+        //  @param source - The location containing the pointer.
+        //  @return The protected pointer.
+        //
+        static Node<T>*
+        protect(int index, std::atomic<Node<T>*>& source)
+        {
+            Node<T>* pointer = source.load();
+
+            while (true)
+            {
+                HazardPointers::protect(index, pointer);
+
+                Node<T>* current = source.load();
+
+                if (current == pointer)
+                {
+                    return pointer;
+                }
+                pointer = current;
+            }
+        }
+
+        //
+        //! @fn void enqueue(Node<T>* first, Node<T>* last)
+        //  @brief Link the supplied chain of nodes to the end of the queue.  Uses the first hazard pointer slot.
+        //  @param first - The address of the first node to be added to the end of the queue.
+        //  @param last - The address of the last node to be added to the end of the queue.
+        //
+        void
+        enqueue(Node<T>* first, Node<T>* last)
+        {
+            first->blink = nullptr;
+            link(last).store(nullptr, std::memory_order_relaxed);
+            while (true)
+            {
+                Node<T>* end = protect(0, tail);
+                Node<T>* next = link(end).load(std::memory_order_acquire);
+
+                if (tail.load() != end)
+                {
+                    continue;
+                }
+                if (next != nullptr)
+                {
+                    tail.compare_exchange_strong(end, next);
+                    continue;
+                }
+                if (link(end).compare_exchange_strong(next, first, std::memory_order_release, std::memory_order_relaxed))
+                {
+                    tail.compare_exchange_strong(end, last);
+                    return;
+                }
+            }
+        }
+
+        //
+        //! @fn void requeueStub()
+        //  @brief Put the stub back on the end of the queue, unless another thread has already done so.
+        //
+        void
+        requeueStub()
+        {
+            bool expected = false;
+
+            if (stubLinked.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                enqueue(&stub, &stub);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        static_assert(alignof(Node<T>*) >= std::atomic_ref<Node<T>*>::required_alignment);
+
+        alignas(64) std::atomic<Node<T>*> head;     //!< The node at the front of the queue (possibly the stub).
+        alignas(64) std::atomic<Node<T>*> tail;     //!< The node at the end of the queue (possibly the stub).
+        alignas(64) std::atomic<bool> stubLinked;   //!< Indicates the stub is in the queue, or is being put there.
+        Node<T> stub;                               //!< Takes the place of a node when the queue is drained.
+};
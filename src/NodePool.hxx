@@ -0,0 +1,494 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definition of a slab allocator for Node items.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added emplace, which constructs the Node data in place.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Reject a zero slab or batch size, which made refill and take loop forever.
+//
+//  V01.003 16-Oct-2026 Jonathan D. Belanger
+//  Align the slabs to the Node when it needs more than a cache line.
+//
+//  V01.004 16-Oct-2026 Jonathan D. Belanger
+//  Remove a thread's free list entries for pools that have been destroyed.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//
+//! @class NodePool
+//  @brief Hands out and recycles Node items carved from contiguous, cache-line aligned slabs.  Each thread has its own
+//         free list, so a steady-state allocate/deallocate does not take a lock or call malloc.  Free lists that grow
+//         too long, or run dry, trade batches of nodes with a shared depot.
+//  @tparam T Type of the data to be stored in a Node
+//  @note This class is thread-safe.  A node may be returned to the pool by a different thread than the one that
+//        allocated it.  All nodes must be returned before the pool is destroyed.
+//
+template <class T>
+class NodePool
+{
+    public:
+        static constexpr std::size_t cacheLine = 64;    //!< The minimum alignment of each slab.
+
+        //
+        //! @fn NodePool(std::size_t slabNodes, std::size_t batchNodes)
+        //  @brief Constructor
+        //  @param slabNodes - The number of nodes carved out of each slab.
+        //  @param batchNodes - The number of nodes moved between a thread's free list and the shared depot.
+        //  @throws std::invalid_argument - slabNodes or batchNodes is zero.
+        //
+        explicit NodePool(std::size_t slabNodes = 1024, std::size_t batchNodes = 64) :
+            id(nextId.fetch_add(1, std::memory_order_relaxed)),
+            shared(std::make_shared<Shared>(slabNodes, (batchNodes < slabNodes) ? batchNodes : slabNodes))
+        {}
+
+        //
+        //! @fn ~NodePool()
+        //  @brief Destructor.  The slabs are released once no exiting thread is still returning nodes to them.
+        //
+        ~NodePool() = default;
+
+        //
+        //! @fn NodePool(const NodePool&)
+        //  @brief Disable the ability to copy this class via another NodePool.
+        //  @param NodePool A reference to a NodePool.
+        //
+        NodePool(const NodePool&) = delete;
+
+        //
+        //! @fn NodePool& operator=(NodePool&)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param NodePool A reference to a NodePool.
+        //  @retval NodePool A reference to a NodePool.
+        //
+        NodePool& operator=(const NodePool&) = delete;
+
+        //
+        //! @fn Node<T>* allocate()
+        //  @brief Construct a Node, with default data, in a slot from the pool.
+        //  @return The address of an unlinked node.
+        //
+        Node<T>*
+        allocate()
+        {
+            Slot* slot = take();
+
+            try
+            {
+                return new (slot->storage) Node<T>();
+            }
+            catch (...)
+            {
+                give(slot);
+                throw;
+            }
+        }
+
+        //
+        //! @fn Node<T>* allocate(T data)
+        //  @brief Construct a Node, containing the supplied data, in a slot from the pool.
+        //  @param data - The data to be stored in the node.
+        //  @return The address of an unlinked node.
+        //
+        Node<T>*
+        allocate(T data)
+        {
+            return emplace(std::move(data));
+        }
+
+        //
+        //! @fn Node<T>* emplace(Args&&... args)
+        //  @brief Construct a Node in a slot from the pool, building its data in place.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return The address of an unlinked node.
+        //
+        template <class... Args>
+        Node<T>*
+        emplace(Args&&... args)
+        {
+            Slot* slot = take();
+
+            try
+            {
+                return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                give(slot);
+                throw;
+            }
+        }
+
+        //
+        //! @fn void deallocate(Node<T>* node)
+        //  @brief Destroy the supplied node and return its slot to the calling thread's free list.
+        //  @param node - The address of an unlinked node previously returned by allocate.
+        //
+        void
+        deallocate(Node<T>* node)
+        {
+            node->~Node<T>();
+            give(reinterpret_cast<Slot*>(node));
+        }
+
+        //
+        //! @fn std::size_t slabCount()
+        //  @brief Return the number of slabs the pool has allocated.
+        //  @return The number of slabs.
+        //
+        std::size_t
+        slabCount()
+        {
+            std::lock_guard<std::mutex> guard(shared->lock);
+
+            return shared->slabs.size();
+        }
+
+    private:
+
+        //
+        //! @union Slot
+        //  @brief The storage for a single Node, which is linked into a free list when not in use.
+        //
+        union Slot
+        {
+            Slot* next;                                             //!< The next free slot.
+            alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];//!< The storage for the Node.
+        };
+
+        static constexpr std::size_t slabAlignment = std::max(cacheLine, alignof(Slot));   //!< Alignment of a slab.
+
+        //
+        //! @struct LocalList
+        //  @brief The free list of a single thread.
+        //
+        struct alignas(cacheLine) LocalList
+        {
+            Slot* head = nullptr;                                   //!< The first free slot.
+            std::size_t count = 0;                                  //!< The number of free slots.
+        };
+
+        //
+        //! @struct Chain
+        //  @brief A batch of free slots held in the depot.
+        //
+        struct Chain
+        {
+            Slot* head;                                             //!< The first slot in the batch.
+            std::size_t count;                                      //!< The number of slots in the batch.
+        };
+
+        //
+        //! @struct Shared
+        //  @brief The state shared by all the threads using the pool.
+        //
+        struct Shared
+        {
+            Shared(std::size_t slabNodes, std::size_t batchNodes) :
+                slabNodes(slabNodes),
+                batchNodes(batchNodes)
+            {
+                if ((slabNodes == 0) || (batchNodes == 0))
+                {
+                    throw std::invalid_argument("NodePool slab and batch sizes must be at least one node");
+                }
+            }
+
+            ~Shared()
+            {
+                for (Slot* slab : slabs)
+                {
+                    ::operator delete(slab, std::align_val_t(slabAlignment));
+                }
+            }
+
+            std::mutex lock;                                        //!< Protects the remainder of this structure.
+            std::vector<Slot*> slabs;                               //!< Every slab allocated.
+            std::vector<Chain> depot;                               //!< Batches of free slots.
+            std::vector<std::unique_ptr<LocalList>> lists;          //!< Every thread's free list.
+            std::vector<LocalList*> idle;                           //!< Free lists of threads that have exited.
+            const std::size_t slabNodes;                            //!< Number of slots per slab.
+            const std::size_t batchNodes;                           //!< Number of slots per batch.
+        };
+
+        //
+        //! @struct ThreadLists
+        //  @brief The free lists of the calling thread, one per pool it has used.  When the thread exits, the slots
+        //         are returned to the depot of any pool still in existence.  Entries for pools that have been
+        //         destroyed are removed the next time the thread uses a new pool.
+        //
+        struct ThreadLists
+        {
+            ~ThreadLists()
+            {
+                for (auto& [poolId, entry] : lists)
+                {
+                    std::shared_ptr<Shared> pool = entry.first.lock();
+
+                    if (pool)
+                    {
+                        std::lock_guard<std::mutex> guard(pool->lock);
+
+                        if (entry.second->count > 0)
+                        {
+                            pool->depot.push_back(Chain{entry.second->head, entry.second->count});
+                        }
+                        entry.second->head = nullptr;
+                        entry.second->count = 0;
+                        pool->idle.push_back(entry.second);
+                    }
+                }
+            }
+
+            std::unordered_map<std::uint64_t, std::pair<std::weak_ptr<Shared>, LocalList*>> lists;
+        };
+
+        //
+        //! @struct Recent
+        //  @brief The free list of the pool the calling thread used most recently.
+        //
+        struct Recent
+        {
+            std::uint64_t id = 0;                                   //!< The identifier of the pool.
+            LocalList* list = nullptr;                              //!< The calling thread's free list.
+        };
+
+        //
+        //! @fn LocalList* local()
+        //  @brief Return the calling thread's free list for this pool.
+        //  @return The address of the free list.
+        //
+        LocalList*
+        local()
+        {
+            Recent& last = recent();
+
+            if (last.id != id)
+            {
+                last.list = attach();
+                last.id = id;
+            }
+            return last.list;
+        }
+
+        //
+        //! @fn LocalList* attach()
+        //  @brief Find, or create, the calling thread's free list for this pool.
+        //  @return The address of the free list.
+        //
+        LocalList*
+        attach()
+        {
+            ThreadLists& mine = threadLists();
+            auto found = mine.lists.find(id);
+
+            if (found != mine.lists.end())
+            {
+                return found->second.second;
+            }
+
+            LocalList* list = nullptr;
+            {
+                std::lock_guard<std::mutex> guard(shared->lock);
+
+                if (shared->idle.empty())
+                {
+                    shared->lists.push_back(std::make_unique<LocalList>());
+                    list = shared->lists.back().get();
+                }
+                else
+                {
+                    list = shared->idle.back();
+                    shared->idle.pop_back();
+                }
+            }
+
+            //
+            // Pool identifiers are never reused, so the entries of pools that no longer exist would never be looked up
+            // again.  Drop them here, so a thread that uses many short-lived pools does not keep growing the map.
+            //
+            std::erase_if(mine.lists, [](const auto& entry) { return entry.second.first.expired(); });
+            mine.lists.emplace(id, std::make_pair(std::weak_ptr<Shared>(shared), list));
+            return list;
+        }
+
+        //
+        //! @fn Slot* take()
+        //  @brief Remove a slot from the calling thread's free list, refilling it first if it is empty.
+        //  @return The address of a free slot.
+        //
+        Slot*
+        take()
+        {
+            LocalList* list = local();
+
+            if (list->head == nullptr)
+            {
+                refill(list);
+            }
+
+            Slot* slot = list->head;
+
+            list->head = slot->next;
+            list->count--;
+            return slot;
+        }
+
+        //
+        //! @fn void give(Slot* slot)
+        //  @brief Add a slot to the calling thread's free list, spilling a batch to the depot if it is too long.
+        //  @param slot - The address of the slot being freed.
+        //
+        void
+        give(Slot* slot)
+        {
+            LocalList* list = local();
+
+            slot->next = list->head;
+            list->head = slot;
+            if (++list->count >= (2 * shared->batchNodes))
+            {
+                spill(list);
+            }
+        }
+
+        //
+        //! @fn void refill(LocalList* list)
+        //  @brief Move a batch from the depot to the supplied (empty) free list, allocating a new slab when the depot
+        //         is also empty.
+        //  @param list - The free list to be refilled.
+        //
+        void
+        refill(LocalList* list)
+        {
+            std::lock_guard<std::mutex> guard(shared->lock);
+
+            if (!shared->depot.empty())
+            {
+                list->head = shared->depot.back().head;
+                list->count = shared->depot.back().count;
+                shared->depot.pop_back();
+                return;
+            }
+
+            Slot* slab = static_cast<Slot*>(::operator new(shared->slabNodes * sizeof(Slot),
+                                                           std::align_val_t(slabAlignment)));
+
+            shared->slabs.push_back(slab);
+
+            //
+            // Carve the slab into batches, keep the first one and put the rest in the depot.
+            //
+            for (std::size_t first = 0; first < shared->slabNodes; first += shared->batchNodes)
+            {
+                std::size_t count = shared->slabNodes - first;
+
+                if (count > shared->batchNodes)
+                {
+                    count = shared->batchNodes;
+                }
+                for (std::size_t ii = first; ii < (first + count); ii++)
+                {
+                    slab[ii].next = (ii + 1 < (first + count)) ? &slab[ii + 1] : nullptr;
+                }
+                if (first == 0)
+                {
+                    list->head = slab;
+                    list->count = count;
+                }
+                else
+                {
+                    shared->depot.push_back(Chain{&slab[first], count});
+                }
+            }
+        }
+
+        //
+        //! @fn void spill(LocalList* list)
+        //  @brief Move a batch from the supplied free list to the depot.
+        //  @param list - The free list to be trimmed.
+        //
+        void
+        spill(LocalList* list)
+        {
+            Slot* first = list->head;
+            Slot* last = first;
+
+            for (std::size_t ii = 1; ii < shared->batchNodes; ii++)
+            {
+                last = last->next;
+            }
+            list->head = last->next;
+            list->count -= shared->batchNodes;
+            last->next = nullptr;
+
+            std::lock_guard<std::mutex> guard(shared->lock);
+
+            shared->depot.push_back(Chain{first, shared->batchNodes});
+        }
+
+        //
+        //! @fn Recent& recent()
+        //  @brief Return the calling thread's most recently used free list.
+        //  @return A reference to the cached free list.
+        //
+        static Recent&
+        recent()
+        {
+            thread_local Recent last;
+
+            return last;
+        }
+
+        //
+        //! @fn ThreadLists& threadLists()
+        //  @brief Return all the calling thread's free lists.
+        //  @return A reference to the free lists.
+        //
+        static ThreadLists&
+        threadLists()
+        {
+            thread_local ThreadLists mine;
+
+            return mine;
+        }
+
+        static inline std::atomic<std::uint64_t> nextId{1};        //!< Identifier of the next pool created.
+
+        const std::uint64_t id;                                     //!< Identifies this pool to the free lists.
+        std::shared_ptr<Shared> shared;                             //!< The state shared by all the threads.
+};
@@ -0,0 +1,857 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definitions to support a queue whose nodes are kept in a memory-mapped file
+//  and whose operations are recorded in an append-only journal, so the queue survives the process crashing.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Reuse a deallocated node straight away when its pop has already been committed.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Open the new journal in checkpoint() only after the commit, and close it if writing it fails.
+//
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+template <class T> class PersistentQueueHead;
+
+//
+//! @class PersistentNode
+//  @brief A node kept in the file of a PersistentQueueHead.  PersistentNode items are only created by the
+//         PersistentQueueHead, and are returned to it when no longer needed.
+//  @tparam T Type of the data to be stored in a PersistentNode.  It must be trivially copyable, and must not contain
+//          pointers, since they would not be meaningful after a restart.
+//
+template <class T>
+class PersistentNode
+{
+    static_assert(std::is_trivially_copyable_v<T>, "PersistentNode data must be trivially copyable");
+
+    friend class PersistentQueueHead<T>;
+
+    public:
+
+        //
+        //! @fn PersistentNode(const PersistentNode &)
+        //  @brief Disable the ability to copy this class via another PersistentNode.
+        //  @param PersistentNode A reference to a PersistentNode.
+        //
+        PersistentNode(const PersistentNode&) = delete;
+
+        //
+        //! @fn PersistentNode& operator=(PersistentNode &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param PersistentNode A reference to a PersistentNode.
+        //  @retval PersistentNode A reference to a PersistentNode.
+        //
+        PersistentNode&
+        operator=(const PersistentNode&) = delete;
+
+        //
+        //! @fn T& data()
+        //  @brief Return a reference to the data, in the mapped file, associated with this node.
+        //  @return A reference to the data stored in the node.
+        //
+        T&
+        data()
+        {
+            return nodeData;
+        }
+
+        //
+        //! @fn const T& data() const
+        //  @brief Return a const reference to the data, in the mapped file, associated with this node.
+        //  @return A const reference to the data stored in the node.
+        //
+        const T&
+        data() const
+        {
+            return nodeData;
+        }
+
+    private:
+
+        //
+        //! @fn PersistentNode()
+        //  @brief Default Constructor
+        //
+        PersistentNode() = default;
+
+        std::uint64_t flink;    //!< Slot of the next node in the queue, zero for the header.
+        std::uint64_t blink;    //!< Slot of the previous node in the queue, zero for the header.
+        T nodeData;             //!< The data stored in the node.
+};
+
+//
+//! @class PersistentQueueHead
+//  @brief A header for a queue of PersistentNode items that survives the process crashing.  The nodes are slots in a
+//         memory-mapped file (path.nodes), and every push and pop is appended to a journal (path.journal).  The journal
+//         is written, and synced, in groups: a group is committed when it reaches the group commit size, or when
+//         commit() is called, so the cost of a sync is shared by many operations.  Operations that have not been
+//         committed when the process dies are lost.
+//
+//         When the files already exist, the queue is recovered by replaying the journal, which rebuilds the links in
+//         the node file.  Replay stops at the first record that is torn or does not match the queue, and the journal
+//         is then rewritten (checkpointed) as one push per node, so the next recovery is as short as possible.
+//  @tparam T Type of the data to be stored in the queue.
+//  @note This class is not thread-safe.  A node that has been deallocated is not reused until its pop has been
+//        committed, so its slot in the file cannot be overwritten while the journal still has it in the queue.  A
+//        popped node that is pushed again, rather than deallocated, must not have its data changed until then.
+//
+template <class T>
+class PersistentQueueHead
+{
+    public:
+        using size_type = std::uint64_t;                        //!< The type used for node counts.
+        static constexpr std::uint64_t fileMagic = 0x5354415850455253;  //!< Identifies a node file.
+        static constexpr std::uint32_t fileVersion = 1;         //!< The layout version of the node file.
+
+        //
+        //! @fn PersistentQueueHead(const std::string& path, size_type capacity, std::size_t groupCommit)
+        //  @brief Constructor, which creates the files for an empty queue, or recovers the queue from existing files.
+        //  @param path - The path of the files, without the .nodes and .journal suffixes.
+        //  @param capacity - The number of nodes in the node file.  It must match an existing file.
+        //  @param groupCommit - The number of operations committed together.
+        //  @throw std::system_error - A file could not be created, opened, mapped or written.
+        //  @throw std::runtime_error - The node file exists but does not match T or the capacity.
+        //
+        PersistentQueueHead(const std::string& path, size_type capacity, std::size_t groupCommit = 64) :
+            journalPath(path + ".journal"),
+            nodeTotal(capacity),
+            nodeCount(0),
+            commitSize((groupCommit == 0) ? 1 : groupCommit)
+        {
+            try
+            {
+                openNodes(path + ".nodes");
+                journalFd = ::open(journalPath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0600);
+                if (journalFd < 0)
+                {
+                    failed("open " + journalPath);
+                }
+                recover();
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        //
+        //! @fn ~PersistentQueueHead()
+        //  @brief Destructor, which commits any outstanding operations and closes the files.
+        //
+        ~PersistentQueueHead()
+        {
+            try
+            {
+                commit();
+            }
+            catch (const std::system_error&)
+            {
+            }
+            release();
+        }
+
+        //
+        //! @fn PersistentQueueHead(const PersistentQueueHead &)
+        //  @brief Disable the ability to copy this class via another PersistentQueueHead.
+        //  @param PersistentQueueHead A reference to a PersistentQueueHead.
+        //
+        PersistentQueueHead(const PersistentQueueHead&) = delete;
+
+        //
+        //! @fn PersistentQueueHead& operator=(PersistentQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param PersistentQueueHead A reference to a PersistentQueueHead.
+        //  @retval PersistentQueueHead A reference to a PersistentQueueHead.
+        //
+        PersistentQueueHead&
+        operator=(const PersistentQueueHead&) = delete;
+
+        //
+        //! @fn void remove(const std::string& path)
+        //  @brief Delete the files of a queue, which must not be open.
+        //  @param path - The path of the files, without the .nodes and .journal suffixes.
+        //
+        static void
+        remove(const std::string& path)
+        {
+            ::unlink((path + ".nodes").c_str());
+            ::unlink((path + ".journal").c_str());
+        }
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no nodes in the queue (the queue is empty).
+        //  @return true - There are no nodes currently in the queue.
+        //  @return false - There are is at least one node currently in the queue.
+        //
+        bool
+        isEmpty()
+        {
+            return nodeCount == 0;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in the queue.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            return nodeCount;
+        }
+
+        //
+        //! @fn size_type capacity()
+        //  @brief Return the number of nodes in the node file.
+        //  @return The number of nodes, whether queued, free or allocated.
+        //
+        size_type
+        capacity()
+        {
+            return nodeTotal;
+        }
+
+        //
+        //! @fn PersistentNode<T>* allocate()
+        //  @brief Take a free node from the node file.
+        //  @return node - The address of the node.
+        //  @return nullptr - All the nodes are in use, or are waiting for their pop to be committed.
+        //
+        PersistentNode<T>*
+        allocate()
+        {
+            if (freeSlots.empty())
+            {
+                return nullptr;
+            }
+
+            std::uint64_t slot = freeSlots.back();
+
+            freeSlots.pop_back();
+            return &slots[slot];
+        }
+
+        //
+        //! @fn void deallocate(PersistentNode<T>* node)
+        //  @brief Return a node, which must not be in the queue, to be reused once outstanding pops are committed.  If
+        //         every operation has already been committed, the node can be reused straight away.
+        //  @param node - The address of the node to be returned.
+        //
+        void
+        deallocate(PersistentNode<T>* node)
+        {
+            std::uint64_t slot = static_cast<std::uint64_t>(node - slots);
+
+            if (pending.empty())
+            {
+                freeSlots.push_back(slot);
+            }
+            else
+            {
+                released.push_back(slot);
+            }
+        }
+
+        //
+        //! @fn void push_forward(PersistentNode<T>* node)
+        //  @brief Add the supplied node to the front of the queue.  Its data must already be filled in.
+        //  @param node - The address of the node to be added to the front of the queue.
+        //
+        void
+        push_forward(PersistentNode<T>* node)
+        {
+            std::uint64_t slot = static_cast<std::uint64_t>(node - slots);
+
+            link(0, slot);
+            pushed(slot);
+            record(Operation::pushForward, slot);
+        }
+
+        //
+        //! @fn void push_backward(PersistentNode<T>* node)
+        //  @brief Add the supplied node to the tail of the queue.  Its data must already be filled in.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //
+        void
+        push_backward(PersistentNode<T>* node)
+        {
+            std::uint64_t slot = static_cast<std::uint64_t>(node - slots);
+
+            link(slots[0].blink, slot);
+            pushed(slot);
+            record(Operation::pushBackward, slot);
+        }
+
+        //
+        //! @fn bool emplace_backward(Args&&... args)
+        //  @brief Take a free node, construct its data from the supplied arguments and add it to the tail of the queue.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return true - The node was added to the queue.
+        //  @return false - There are no free nodes.
+        //
+        template <class... Args>
+        bool
+        emplace_backward(Args&&... args)
+        {
+            PersistentNode<T>* node = allocate();
+
+            if (node == nullptr)
+            {
+                return false;
+            }
+            ::new (static_cast<void*>(&node->nodeData)) T(std::forward<Args>(args)...);
+            push_backward(node);
+            return true;
+        }
+
+        //
+        //! @fn PersistentNode<T>* pop_forward()
+        //  @brief Remove the first node in the queue.  The data can be read in place until the node is deallocated.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        PersistentNode<T>*
+        pop_forward()
+        {
+            std::uint64_t slot = slots[0].flink;
+
+            if (slot == 0)
+            {
+                return nullptr;
+            }
+            unlink(slot);
+            record(Operation::popForward, slot);
+            return &slots[slot];
+        }
+
+        //
+        //! @fn PersistentNode<T>* pop_backward()
+        //  @brief Remove the last node in the queue.  The data can be read in place until the node is deallocated.
+        //  @return node - The address of the node removed from the end of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        PersistentNode<T>*
+        pop_backward()
+        {
+            std::uint64_t slot = slots[0].blink;
+
+            if (slot == 0)
+            {
+                return nullptr;
+            }
+            unlink(slot);
+            record(Operation::popBackward, slot);
+            return &slots[slot];
+        }
+
+        //
+        //! @fn void commit()
+        //  @brief Make every operation so far durable.  The data of the pushed nodes is synced before the journal
+        //         records that refer to it are written and synced.  Nodes deallocated since the last commit become
+        //         free.
+        //
+        void
+        commit()
+        {
+            if (pending.empty())
+            {
+                freeSlots.insert(freeSlots.end(), released.begin(), released.end());
+                released.clear();
+                return;
+            }
+            if (dirtyHigh != 0)
+            {
+                std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                std::size_t low = (reinterpret_cast<char*>(&slots[dirtyLow]) - mapping) / page * page;
+                std::size_t high = reinterpret_cast<char*>(&slots[dirtyHigh + 1]) - mapping;
+
+                if (::msync(mapping + low, high - low, MS_SYNC) != 0)
+                {
+                    failed("msync");
+                }
+                dirtyLow = ~std::uint64_t(0);
+                dirtyHigh = 0;
+            }
+            append(journalFd, pending.data(), pending.size() * sizeof(Record));
+            if (::fsync(journalFd) != 0)
+            {
+                failed("fsync " + journalPath);
+            }
+            pending.clear();
+            freeSlots.insert(freeSlots.end(), released.begin(), released.end());
+            released.clear();
+        }
+
+        //
+        //! @fn void checkpoint()
+        //  @brief Commit, then replace the journal with one push per node currently in the queue, so it no longer
+        //         grows with the number of operations ever done.
+        //
+        void
+        checkpoint()
+        {
+            std::string newPath = journalPath + ".new";
+            std::vector<Record> records;
+
+            commit();
+            records.reserve(nodeCount);
+            for (std::uint64_t slot = slots[0].flink; slot != 0; slot = slots[slot].flink)
+            {
+                records.push_back(makeRecord(Operation::pushBackward, slot));
+            }
+
+            int fd = ::open(newPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+            if (fd < 0)
+            {
+                failed("open " + newPath);
+            }
+            try
+            {
+                append(fd, records.data(), records.size() * sizeof(Record));
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+            if ((::fsync(fd) != 0) || (::rename(newPath.c_str(), journalPath.c_str()) != 0))
+            {
+                int error = errno;
+
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "checkpoint " + journalPath);
+            }
+            ::close(fd);
+            syncDirectory();
+            ::close(journalFd);
+            journalFd = ::open(journalPath.c_str(), O_RDWR | O_APPEND);
+            if (journalFd < 0)
+            {
+                failed("open " + journalPath);
+            }
+        }
+
+    private:
+
+        //
+        //! @enum Operation
+        //  @brief The operations recorded in the journal.
+        //
+        enum class Operation : std::uint32_t
+        {
+            pushForward = 1,
+            pushBackward,
+            popForward,
+            popBackward
+        };
+
+        //
+        //! @struct Record
+        //  @brief A journal record.  The check value detects a record that was only partly written.
+        //
+        struct Record
+        {
+            Operation op;               //!< The operation.
+            std::uint32_t check;        //!< A hash of the operation and slot.
+            std::uint64_t slot;         //!< The slot of the node pushed or popped.
+        };
+
+        //
+        //! @struct FileHeader
+        //  @brief The start of the node file, identifying its layout.
+        //
+        struct FileHeader
+        {
+            std::uint64_t magic;        //!< Set to fileMagic.
+            std::uint32_t version;      //!< Set to fileVersion.
+            std::uint32_t nodeSize;     //!< The size of each node, to catch a mismatched T.
+            std::uint64_t capacity;     //!< The number of nodes, not counting the header slot.
+        };
+
+        static constexpr std::uint64_t unlinked = ~std::uint64_t(0);    //!< The links of a node not in the queue.
+        static constexpr std::size_t cacheLine = 64;                    //!< The alignment of the first slot.
+
+        //
+        //! @fn std::size_t firstSlot()
+        //  @brief Return the offset in the node file of slot zero, which holds the links of the queue header.
+        //  @return The offset of the first slot.
+        //
+        static constexpr std::size_t
+        firstSlot()
+        {
+            return ((sizeof(FileHeader) + cacheLine - 1) / cacheLine) * cacheLine;
+        }
+
+        //
+        //! @fn std::uint32_t checkValue(Operation op, std::uint64_t slot)
+        //  @brief Return the check value of a journal record.
+        //  @param op - The operation.
+        //  @param slot - The slot of the node.
+        //  @return The hash of the operation and slot.
+        //
+        static std::uint32_t
+        checkValue(Operation op, std::uint64_t slot)
+        {
+            std::uint64_t hash = (slot ^ (static_cast<std::uint64_t>(op) << 56)) * 0x9E3779B97F4A7C15;
+
+            return static_cast<std::uint32_t>(hash >> 32) ^ 0x5A5A5A5A;
+        }
+
+        //
+        //! @fn Record makeRecord(Operation op, std::uint64_t slot)
+        //  @brief Build a journal record.
+        //  @param op - The operation.
+        //  @param slot - The slot of the node.
+        //  @return The record.
+        //
+        static Record
+        makeRecord(Operation op, std::uint64_t slot)
+        {
+            return Record{op, checkValue(op, slot), slot};
+        }
+
+        //
+        //! @fn void failed(const std::string& what)
+        //  @brief Throw the error of the system call that just failed.
+        //  @param what - The system call, and the file it was for.
+        //
+        [[noreturn]] static void
+        failed(const std::string& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        //
+        //! @fn void append(int fd, const void* buffer, std::size_t bytes)
+        //  @brief Write all of a buffer to a file.
+        //  @param fd - The descriptor of the file.
+        //  @param buffer - The data to be written.
+        //  @param bytes - The number of bytes to be written.
+        //
+        void
+        append(int fd, const void* buffer, std::size_t bytes)
+        {
+            const char* next = static_cast<const char*>(buffer);
+
+            while (bytes > 0)
+            {
+                ssize_t written = ::write(fd, next, bytes);
+
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    failed("write " + journalPath);
+                }
+                next += written;
+                bytes -= static_cast<std::size_t>(written);
+            }
+        }
+
+        //
+        //! @fn void release()
+        //  @brief Close the files and unmap the node file, whichever of them are open.
+        //
+        void
+        release()
+        {
+            if (journalFd >= 0)
+            {
+                ::close(journalFd);
+            }
+            if (mapping != nullptr)
+            {
+                ::munmap(mapping, mappingBytes);
+            }
+            if (nodeFd >= 0)
+            {
+                ::close(nodeFd);
+            }
+        }
+
+        //
+        //! @fn void syncDirectory()
+        //  @brief Sync the directory holding the journal, so a rename of it is durable.
+        //
+        void
+        syncDirectory()
+        {
+            std::filesystem::path directory = std::filesystem::path(journalPath).parent_path();
+            int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+
+            if (fd >= 0)
+            {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+
+        //
+        //! @fn void openNodes(const std::string& nodePath)
+        //  @brief Open, or create, and map the node file.
+        //  @param nodePath - The path of the node file.
+        //
+        void
+        openNodes(const std::string& nodePath)
+        {
+            struct stat status;
+
+            mappingBytes = firstSlot() + ((nodeTotal + 1) * sizeof(PersistentNode<T>));
+            nodeFd = ::open(nodePath.c_str(), O_RDWR | O_CREAT, 0600);
+            if ((nodeFd < 0) || (::fstat(nodeFd, &status) != 0))
+            {
+                failed("open " + nodePath);
+            }
+
+            bool created = (status.st_size == 0);
+
+            if (created && (::ftruncate(nodeFd, static_cast<off_t>(mappingBytes)) != 0))
+            {
+                failed("ftruncate " + nodePath);
+            }
+            if (!created && (static_cast<std::size_t>(status.st_size) != mappingBytes))
+            {
+                throw std::runtime_error(nodePath + " was created with a different capacity or node type");
+            }
+            mapping = static_cast<char*>(::mmap(nullptr, mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, nodeFd, 0));
+            if (mapping == MAP_FAILED)
+            {
+                mapping = nullptr;
+                failed("mmap " + nodePath);
+            }
+
+            FileHeader* header = reinterpret_cast<FileHeader*>(mapping);
+
+            if (created)
+            {
+                *header = FileHeader{fileMagic, fileVersion, sizeof(PersistentNode<T>), nodeTotal};
+                if (::msync(mapping, firstSlot(), MS_SYNC) != 0)
+                {
+                    failed("msync " + nodePath);
+                }
+            }
+            else if ((header->magic != fileMagic) ||
+                     (header->version != fileVersion) ||
+                     (header->nodeSize != sizeof(PersistentNode<T>)) ||
+                     (header->capacity != nodeTotal))
+            {
+                throw std::runtime_error(nodePath + " was created with a different capacity or node type");
+            }
+            slots = reinterpret_cast<PersistentNode<T>*>(mapping + firstSlot());
+        }
+
+        //
+        //! @fn void recover()
+        //  @brief Rebuild the links of the queue, and the free nodes, by replaying the journal.
+        //
+        void
+        recover()
+        {
+            struct stat status;
+            std::size_t records = 0;
+            std::size_t replayed = 0;
+
+            slots[0].flink = 0;
+            slots[0].blink = 0;
+            for (std::uint64_t slot = 1; slot <= nodeTotal; slot++)
+            {
+                slots[slot].flink = unlinked;
+                slots[slot].blink = unlinked;
+            }
+            if (::fstat(journalFd, &status) != 0)
+            {
+                failed("fstat " + journalPath);
+            }
+            records = static_cast<std::size_t>(status.st_size) / sizeof(Record);
+            if (records > 0)
+            {
+                void* journal = ::mmap(nullptr, records * sizeof(Record), PROT_READ, MAP_PRIVATE, journalFd, 0);
+
+                if (journal == MAP_FAILED)
+                {
+                    failed("mmap " + journalPath);
+                }
+                ::madvise(journal, records * sizeof(Record), MADV_SEQUENTIAL);
+                replayed = replay(static_cast<const Record*>(journal), records);
+                ::munmap(journal, records * sizeof(Record));
+            }
+
+            freeSlots.reserve(nodeTotal - nodeCount);
+            for (std::uint64_t slot = nodeTotal; slot > 0; slot--)
+            {
+                if (slots[slot].flink == unlinked)
+                {
+                    freeSlots.push_back(slot);
+                }
+            }
+            if ((replayed != nodeCount) || (static_cast<std::size_t>(status.st_size) != replayed * sizeof(Record)))
+            {
+                checkpoint();
+            }
+        }
+
+        //
+        //! @fn std::size_t replay(const Record* journal, std::size_t records)
+        //  @brief Apply journal records to the queue, stopping at the first one that is torn or does not match it.
+        //  @param journal - The first record.
+        //  @param records - The number of records.
+        //  @return The number of records applied.
+        //
+        std::size_t
+        replay(const Record* journal, std::size_t records)
+        {
+            for (std::size_t ii = 0; ii < records; ii++)
+            {
+                const Record& entry = journal[ii];
+
+                if ((entry.check != checkValue(entry.op, entry.slot)) || (entry.slot == 0) || (entry.slot > nodeTotal))
+                {
+                    return ii;
+                }
+                switch (entry.op)
+                {
+                    case Operation::pushForward:
+                    case Operation::pushBackward:
+                        if (slots[entry.slot].flink != unlinked)
+                        {
+                            return ii;
+                        }
+                        link((entry.op == Operation::pushForward) ? 0 : slots[0].blink, entry.slot);
+                        break;
+
+                    case Operation::popForward:
+                    case Operation::popBackward:
+                        if (entry.slot != ((entry.op == Operation::popForward) ? slots[0].flink : slots[0].blink))
+                        {
+                            return ii;
+                        }
+                        unlink(entry.slot);
+                        slots[entry.slot].flink = unlinked;
+                        slots[entry.slot].blink = unlinked;
+                        break;
+
+                    default:
+                        return ii;
+                }
+            }
+            return records;
+        }
+
+        //
+        //! @fn void link(std::uint64_t pred, std::uint64_t slot)
+        //  @brief Insert a node after the supplied slot.
+        //  @param pred - The slot the node goes after, zero for the header.
+        //  @param slot - The slot of the node being inserted.
+        //
+        void
+        link(std::uint64_t pred, std::uint64_t slot)
+        {
+            PersistentNode<T>& node = slots[slot];
+
+            node.flink = slots[pred].flink;
+            node.blink = pred;
+            slots[node.flink].blink = slot;
+            slots[pred].flink = slot;
+            nodeCount++;
+        }
+
+        //
+        //! @fn void unlink(std::uint64_t slot)
+        //  @brief Remove a node from the queue.
+        //  @param slot - The slot of the node being removed.
+        //
+        void
+        unlink(std::uint64_t slot)
+        {
+            PersistentNode<T>& node = slots[slot];
+
+            slots[node.blink].flink = node.flink;
+            slots[node.flink].blink = node.blink;
+            nodeCount--;
+        }
+
+        //
+        //! @fn void pushed(std::uint64_t slot)
+        //  @brief Note that the data of a node has to be synced at the next commit.
+        //  @param slot - The slot of the node pushed.
+        //
+        void
+        pushed(std::uint64_t slot)
+        {
+            dirtyLow = (slot < dirtyLow) ? slot : dirtyLow;
+            dirtyHigh = (slot > dirtyHigh) ? slot : dirtyHigh;
+        }
+
+        //
+        //! @fn void record(Operation op, std::uint64_t slot)
+        //  @brief Add an operation to the group being committed, committing the group if it is full.
+        //  @param op - The operation.
+        //  @param slot - The slot of the node.
+        //
+        void
+        record(Operation op, std::uint64_t slot)
+        {
+            pending.push_back(makeRecord(op, slot));
+            if (pending.size() >= commitSize)
+            {
+                commit();
+            }
+        }
+
+        std::string journalPath;                    //!< The path of the journal.
+        int nodeFd = -1;                            //!< The descriptor of the node file.
+        int journalFd = -1;                         //!< The descriptor of the journal, opened for append.
+        char* mapping = nullptr;                    //!< The address of the mapped node file.
+        std::size_t mappingBytes = 0;               //!< The size of the node file.
+        PersistentNode<T>* slots = nullptr;         //!< The slots, zero being the header.
+        size_type nodeTotal;                        //!< The number of nodes in the node file.
+        size_type nodeCount;                        //!< The number of nodes in the queue.
+        std::size_t commitSize;                     //!< The number of operations committed together.
+        std::vector<Record> pending;                //!< The operations not yet committed.
+        std::vector<std::uint64_t> freeSlots;       //!< The slots that can be allocated.
+        std::vector<std::uint64_t> released;        //!< The slots deallocated since the last commit.
+        std::uint64_t dirtyLow = ~std::uint64_t(0); //!< The lowest slot pushed since the last commit.
+        std::uint64_t dirtyHigh = 0;                //!< The highest slot pushed since the last commit.
+};
@@ -0,0 +1,270 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definitions to support a queue with a fixed number of priority lanes.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  AgingPriority keeps a count for every lane, so a middle lane is not starved when the lanes above and below it are
+//  both backed up.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+//
+//! @class StrictPriority
+//  @brief A lane selection policy that always services the highest priority non-empty lane.
+//
+class StrictPriority
+{
+    public:
+
+        //
+        //! @fn std::size_t select(std::uint64_t lanes)
+        //  @brief Select the lane to service next.
+        //  @param lanes - A bitmap of the non-empty lanes (must not be zero).
+        //  @return The highest priority non-empty lane.
+        //
+        std::size_t
+        select(std::uint64_t lanes)
+        {
+            return 63 - std::countl_zero(lanes);
+        }
+};
+
+//
+//! @class AgingPriority
+//  @brief A lane selection policy that services the highest priority non-empty lane, except that a non-empty lane
+//         passed over Budget times in a row is serviced instead.  Every lane keeps its own count, so each backed up
+//         lane, not just the lowest, is serviced at least once in every Budget + Levels selections.  When more than
+//         one lane is due, the one passed over most often goes first, the higher priority lane on a tie.
+//  @tparam Budget The number of times a lane can be passed over.
+//
+template <std::size_t Budget>
+class AgingPriority
+{
+    public:
+
+        //
+        //! @fn std::size_t select(std::uint64_t lanes)
+        //  @brief Select the lane to service next.
+        //  @param lanes - A bitmap of the non-empty lanes (must not be zero).
+        //  @return The lane to be serviced.
+        //
+        std::size_t
+        select(std::uint64_t lanes)
+        {
+            std::size_t chosen = 63 - std::countl_zero(lanes);
+            std::size_t most = 0;
+            bool due = false;
+
+            for (std::uint64_t bits = lanes; bits != 0; bits &= bits - 1)
+            {
+                std::size_t lane = std::countr_zero(bits);
+
+                if ((passedOver[lane] >= Budget) && (!due || (passedOver[lane] >= most)))
+                {
+                    chosen = lane;
+                    most = passedOver[lane];
+                    due = true;
+                }
+            }
+            for (std::uint64_t bits = lanes; bits != 0; bits &= bits - 1)
+            {
+                passedOver[std::countr_zero(bits)]++;
+            }
+            for (std::uint64_t bits = waiting & ~lanes; bits != 0; bits &= bits - 1)
+            {
+                passedOver[std::countr_zero(bits)] = 0;
+            }
+            passedOver[chosen] = 0;
+            waiting = lanes;
+            return chosen;
+        }
+
+    private:
+        std::array<std::size_t, 64> passedOver{};   //!< Selections since each lane was last serviced.
+        std::uint64_t waiting = 0;                  //!< The lanes that were non-empty at the last selection.
+};
+
+//
+//! @class PriorityQueueHead
+//  @brief A header for a queue of Node items with a fixed number of priority lanes, the highest numbered lane having
+//         the highest priority.  Each lane is a QueueHead, so enqueue is O(1), and a bitmap of the non-empty lanes
+//         lets dequeue find the lane to service with a single count-leading-zeros instruction.
+//  @tparam T The class of the data to be stored in the queue.
+//  @tparam Levels The number of priority lanes (1 to 64).
+//  @tparam Policy The lane selection policy (StrictPriority or AgingPriority).
+//  @note This class is not thread-safe.  A single lock around the whole PriorityQueueHead replaces a lock per lane.
+//
+template <class T, std::size_t Levels, class Policy = StrictPriority>
+class PriorityQueueHead
+{
+    static_assert((Levels >= 1) && (Levels <= 64), "A PriorityQueueHead has from 1 to 64 levels");
+
+    public:
+        using size_type = typename QueueHead<T>::size_type;    //!< The type used for node counts.
+
+        //
+        //! @fn PriorityQueueHead()
+        //  @brief Default Constructor
+        //
+        explicit PriorityQueueHead() :
+            nonEmpty(0),
+            nodeCount(0)
+        {}
+
+        //
+        //! @fn ~PriorityQueueHead()
+        //  @brief Default Destructor
+        //
+        ~PriorityQueueHead() = default;
+
+        //
+        //! @fn PriorityQueueHead(const PriorityQueueHead &)
+        //  @brief Disable the ability to copy this class via another PriorityQueueHead.
+        //  @param PriorityQueueHead A reference to a PriorityQueueHead.
+        //
+        PriorityQueueHead(const PriorityQueueHead&) = delete;
+
+        //
+        //! @fn PriorityQueueHead& operator=(PriorityQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param PriorityQueueHead A reference to a PriorityQueueHead.
+        //  @retval PriorityQueueHead A reference to a PriorityQueueHead.
+        //
+        PriorityQueueHead&
+        operator=(const PriorityQueueHead&) = delete;
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no nodes in any lane.
+        //  @return true - There are no nodes currently in the queue.
+        //  @return false - There are is at least one node currently in the queue.
+        //
+        bool
+        isEmpty()
+        {
+            return nonEmpty == 0;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in all the lanes.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            return nodeCount;
+        }
+
+        //
+        //! @fn QueueHead<T>& lane(std::size_t level)
+        //  @brief Return the queue for a single lane.  Nodes must only be added or removed through the
+        //         PriorityQueueHead, but the lane can be traversed.
+        //  @param level - The priority of the lane.
+        //  @return A reference to the lane.
+        //
+        QueueHead<T>&
+        lane(std::size_t level)
+        {
+            return lanes[level];
+        }
+
+        //
+        //! @fn void push_forward(Node<T>* node, std::size_t level)
+        //  @brief Add the supplied node to the front of a lane.
+        //  @param node - The address of the node to be added.
+        //  @param level - The priority of the lane.
+        //
+        void
+        push_forward(Node<T>* node, std::size_t level)
+        {
+            lanes[level].push_forward(node);
+            nonEmpty |= (std::uint64_t(1) << level);
+            nodeCount++;
+        }
+
+        //
+        //! @fn void push_backward(Node<T>* node, std::size_t level)
+        //  @brief Add the supplied node to the tail of a lane.
+        //  @param node - The address of the node to be added.
+        //  @param level - The priority of the lane.
+        //
+        void
+        push_backward(Node<T>* node, std::size_t level)
+        {
+            lanes[level].push_backward(node);
+            nonEmpty |= (std::uint64_t(1) << level);
+            nodeCount++;
+        }
+
+        //
+        //! @fn Node<T>* pop_forward()
+        //  @brief Remove the first node from the lane chosen by the policy (by default, the highest priority lane).
+        //  @return node - The address of the node removed.
+        //  @return nullptr - All the lanes are empty.
+        //
+        Node<T>*
+        pop_forward()
+        {
+            if (nonEmpty == 0)
+            {
+                return nullptr;
+            }
+            return pop_forward(policy.select(nonEmpty));
+        }
+
+        //
+        //! @fn Node<T>* pop_forward(std::size_t level)
+        //  @brief Remove the first node from a specific lane.
+        //  @param level - The priority of the lane.
+        //  @return node - The address of the node removed.
+        //  @return nullptr - The lane is empty.
+        //
+        Node<T>*
+        pop_forward(std::size_t level)
+        {
+            Node<T>* node = lanes[level].pop_forward();
+
+            if (node != nullptr)
+            {
+                if (lanes[level].isEmpty())
+                {
+                    nonEmpty &= ~(std::uint64_t(1) << level);
+                }
+                nodeCount--;
+            }
+            return node;
+        }
+
+    private:
+        std::uint64_t nonEmpty;                     //!< Bit n is set when lane n contains at least one node.
+        size_type nodeCount;                        //!< The number of nodes in all the lanes.
+        [[no_unique_address]] Policy policy;        //!< Selects the lane to service.
+        std::array<QueueHead<T>, Levels> lanes;     //!< One queue per priority.
+};
@@ -22,13 +22,48 @@
 //  V01.000 16-Apr-2024 Jonathan D. Belanger
 //  Initially written.
 //
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Allow the ConcurrentQueueHead access to the Node links.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Added the push and pop variants that take their nodes from, and return them to, a NodePool.
+//
+//  V01.003 16-Oct-2026 Jonathan D. Belanger
+//  Added the splice, batch pop and chain push operations.
+//
+//  V01.004 16-Oct-2026 Jonathan D. Belanger
+//  Keep a count of the nodes in a QueueHead and allow its capacity to be limited.  The QueueHead now uses the links
+//  of its Node base class, so that inserting or removing a node next to the header with Node::insque/remque keeps
+//  the header consistent.
+//
+//  V01.005 16-Oct-2026 Jonathan D. Belanger
+//  Added bidirectional iterators, erase and insert to the QueueHead.
+//
+//  V01.006 16-Oct-2026 Jonathan D. Belanger
+//  Added reference access to, and move and in-place construction of, the Node data, along with the QueueHead emplace
+//  functions.
+//
+//  V01.007 16-Oct-2026 Jonathan D. Belanger
+//  Added the compile-time instrumentation policy to the QueueHead.
+//
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
 //
-// Forward declaration of the QueueHead.
+// Forward declaration of the NoInstrumentation policy, QueueHead, ConcurrentQueueHead and NodePool.
 //
-template <class T>
+class NoInstrumentation;
+template <class T, class Instrumentation = NoInstrumentation>
 class QueueHead;
+template <class T>
+class ConcurrentQueueHead;
+template <class T>
+class NodePool;
 
 //
 //! @class Node
@@ -40,7 +75,9 @@ template <class T>
 class Node
 {
     public:
-        friend class QueueHead<T>;
+        template <class U, class Instrumentation>
+        friend class QueueHead;
+        friend class ConcurrentQueueHead<T>;
 
         //
         //! @fn Node()
@@ -53,15 +90,37 @@ class Node
         {}
 
        //
-       //! @fn Node()
-       //  @brief Constructor with Data
+       //! @fn Node(const T& data)
+       //  @brief Constructor with Data, which is copied into the node.
        //
-        explicit Node(T data) :
+        explicit Node(const T& data) :
             flink(this),
             blink(this),
             nodeData(data)
         {}
 
+        //
+        //! @fn Node(T&& data)
+        //  @brief Constructor with Data, which is moved into the node.
+        //
+        explicit Node(T&& data) :
+            flink(this),
+            blink(this),
+            nodeData(std::move(data))
+        {}
+
+        //
+        //! @fn Node(std::in_place_t, Args&&... args)
+        //  @brief Constructor that builds the data directly inside the node.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //
+        template <class... Args>
+        explicit Node(std::in_place_t, Args&&... args) :
+            flink(this),
+            blink(this),
+            nodeData(std::forward<Args>(args)...)
+        {}
+
         //
         //! @fn ~Node()
         //  @brief Default Destructor
@@ -101,8 +160,9 @@ class Node
         //  @return true - This node is the only node in the entire queue.
         //  @return false - This node is one of more than one nodes in the queue.
         //
+        template <class Instrumentation>
         bool
-        isOnly(QueueHead<T>* header)
+        isOnly(QueueHead<T, Instrumentation>* header)
         {
             return ((flink == header) && (blink == header));
         }
@@ -174,31 +234,278 @@ class Node
             return nodeData;
         }
 
+        //
+        //! @fn T& data()
+        //  @brief Return a reference to the data in the node, without copying it.
+        //  @return A reference to the nodeData field found in this node.
+        //
+        T&
+        data()
+        {
+            return nodeData;
+        }
+
+        //
+        //! @fn const T& data() const
+        //  @brief Return a constant reference to the data in the node, without copying it.
+        //  @return A constant reference to the nodeData field found in this node.
+        //
+        const T&
+        data() const
+        {
+            return nodeData;
+        }
+
     private:
         Node<T>* flink;             //!< Forward link to the next node in the queue (or the header, or itself).
         Node<T>* blink;             //!< Backward link to the previous node in the queue (or the header, or itself).
         T nodeData;                 //!< The data of the Node class.
 };
 
+//
+//! @concept NodeAllocator
+//  @brief An allocator that can build a Node, with its data constructed in place, and later take it back.  NodePool
+//         is one.
+//
+template <class Allocator, class T, class... Args>
+concept NodeAllocator = requires(Allocator& allocator, Node<T>* node, Args&&... args)
+{
+    { allocator.emplace(std::forward<Args>(args)...) } -> std::same_as<Node<T>*>;
+    allocator.deallocate(node);
+};
+
+//
+//! @class NoInstrumentation
+//  @brief The default instrumentation policy of a QueueHead.  Every hook is empty, so an uninstrumented QueueHead
+//         compiles to exactly the same code as it would without the hooks.  A policy supplies the same static members;
+//         see LatencyInstrumentation.
+//
+class NoInstrumentation
+{
+    public:
+        static constexpr bool enabled = false;      //!< Indicates the hooks do something.
+
+        //
+        //! @fn void pushed(Node<T>* node, std::size_t depth)
+        //  @brief Called after a node has been added to a queue.
+        //  @param node - The address of the node added.
+        //  @param depth - The number of nodes now in the queue.
+        //
+        template <class T>
+        static void
+        pushed(Node<T>*, std::size_t)
+        {}
+
+        //
+        //! @fn void popped(Node<T>* node)
+        //  @brief Called after a node has been removed from a queue.
+        //  @param node - The address of the node removed.
+        //
+        template <class T>
+        static void
+        popped(Node<T>*)
+        {}
+
+        //
+        //! @fn void stolen(std::size_t count)
+        //  @brief Called after nodes have been stolen from another worker's queue.
+        //  @param count - The number of nodes stolen.
+        //
+        static void
+        stolen(std::size_t)
+        {}
+};
+
 //
 //! @class QueueHead
 //  @brief A header for a doubly-linked list (queue) of Node items.
 //  @tparam T The class of the data to be stored in the queue.
-//  @note This class is not thread-safe.
+//  @tparam Instrumentation The policy told about each node added or removed (NoInstrumentation by default).  Nodes
+//          moved between queues by splice_forward, splice_backward and pop_forward_n are not reported.
+//  @note This class is not thread-safe.  The count of nodes is maintained by the QueueHead functions, including the
+//        QueueHead insque and remque.  Calling Node::insque or Node::remque directly on a node in the queue does not
+//        update the count.
 //
-template <class T>
+template <class T, class Instrumentation>
 class QueueHead : private Node<T>
 {
     public:
         friend class Node<T>;
 
+        using size_type = std::size_t;          //!< The type used for node counts.
+        using value_type = T;                   //!< The type of the data in each node.
+        using reference = T&;                   //!< A reference to the data in a node.
+        using const_reference = const T&;       //!< A constant reference to the data in a node.
+
+        //
+        //! @class Iterator
+        //  @brief A bidirectional iterator over the data in the nodes of the queue.  Incrementing past the last node
+        //         reaches end(), which is the header.
+        //  @tparam Const true - The data is accessed through a constant reference.
+        //
+        template <bool Const>
+        class Iterator
+        {
+            public:
+                using iterator_concept = std::bidirectional_iterator_tag;
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = typename std::conditional<Const, const T*, T*>::type;
+                using reference = typename std::conditional<Const, const T&, T&>::type;
+
+                //
+                //! @fn Iterator()
+                //  @brief Default Constructor, for an iterator not associated with any queue.
+                //
+                Iterator() = default;
+
+                //
+                //! @fn Iterator(Node<T>* node)
+                //  @brief Constructor
+                //  @param node - The node the iterator refers to.
+                //
+                explicit Iterator(Node<T>* node) :
+                    current(node)
+                {}
+
+                //
+                //! @fn Iterator(const Iterator<false>& other)
+                //  @brief Convert an iterator to a constant iterator.
+                //  @param other - The iterator to be converted.
+                //
+                template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+                Iterator(const Iterator<OtherConst>& other) :
+                    current(other.node())
+                {}
+
+                //
+                //! @fn Node<T>* node()
+                //  @brief Return the node the iterator refers to.
+                //  @return The address of the node.
+                //
+                Node<T>*
+                node() const
+                {
+                    return current;
+                }
+
+                //
+                //! @fn reference operator*()
+                //  @brief Return a reference to the data in the node.
+                //  @return A reference to the node data.
+                //
+                reference
+                operator*() const
+                {
+                    return current->nodeData;
+                }
+
+                //
+                //! @fn pointer operator->()
+                //  @brief Return the address of the data in the node.
+                //  @return A pointer to the node data.
+                //
+                pointer
+                operator->() const
+                {
+                    return &current->nodeData;
+                }
+
+                //
+                //! @fn Iterator& operator++()
+                //  @brief Move to the next node.
+                //  @return This iterator.
+                //
+                Iterator&
+                operator++()
+                {
+                    current = current->flink;
+                    return *this;
+                }
+
+                //
+                //! @fn Iterator operator++(int)
+                //  @brief Move to the next node.
+                //  @return The iterator before it was moved.
+                //
+                Iterator
+                operator++(int)
+                {
+                    Iterator previous = *this;
+
+                    current = current->flink;
+                    return previous;
+                }
+
+                //
+                //! @fn Iterator& operator--()
+                //  @brief Move to the previous node.
+                //  @return This iterator.
+                //
+                Iterator&
+                operator--()
+                {
+                    current = current->blink;
+                    return *this;
+                }
+
+                //
+                //! @fn Iterator operator--(int)
+                //  @brief Move to the previous node.
+                //  @return The iterator before it was moved.
+                //
+                Iterator
+                operator--(int)
+                {
+                    Iterator previous = *this;
+
+                    current = current->blink;
+                    return previous;
+                }
+
+                //
+                //! @fn bool operator==(const Iterator& other)
+                //  @brief Return a boolean if both iterators refer to the same node.
+                //  @retval true - The iterators refer to the same node.
+                //  @retval false - The iterators refer to different nodes.
+                //
+                bool
+                operator==(const Iterator& other) const
+                {
+                    return current == other.current;
+                }
+
+            private:
+                Node<T>* current = nullptr;     //!< The node the iterator refers to.
+        };
+
+        using iterator = Iterator<false>;                                       //!< Iterator over the data.
+        using const_iterator = Iterator<true>;                                  //!< Constant iterator over the data.
+        using reverse_iterator = std::reverse_iterator<iterator>;               //!< Reverse iterator over the data.
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;   //!< Constant reverse iterator.
+
+        static constexpr size_type unbounded = ~static_cast<size_type>(0);  //!< Capacity of an unlimited queue.
+
         //
         //! @fn QueueHead()
         //  @brief Default Constructor
         //
         explicit QueueHead() :
-            flink(this),
-            blink(this)
+            Node<T>(),
+            nodeCount(0),
+            nodeCapacity(unbounded)
+        {}
+
+        //
+        //! @fn QueueHead(size_type capacity)
+        //  @brief Constructor with a limit on the number of nodes try_push_forward and try_push_backward will allow.
+        //  @param capacity - The maximum number of nodes in the queue.
+        //
+        explicit QueueHead(size_type capacity) :
+            Node<T>(),
+            nodeCount(0),
+            nodeCapacity(capacity)
         {}
 
         //
@@ -259,6 +566,40 @@ class QueueHead : private Node<T>
             return ((flink == this) && (blink == this));
         }
 
+        //
+        //! @fn bool isFull()
+        //  @brief Return an indicator that the queue has reached its capacity.
+        //  @return true - The number of nodes in the queue is at (or above) its capacity.
+        //  @return false - There is room for at least one more node in the queue.
+        //
+        bool
+        isFull()
+        {
+            return nodeCount >= nodeCapacity;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in the queue, without walking it.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            return nodeCount;
+        }
+
+        //
+        //! @fn size_type capacity()
+        //  @brief Return the maximum number of nodes try_push_forward and try_push_backward will allow in the queue.
+        //  @return The capacity of the queue (unbounded if there is no limit).
+        //
+        size_type
+        capacity()
+        {
+            return nodeCapacity;
+        }
+
         //
         //! @fn Node* forward()
         //  @brief Return the next node in the queue (or the header if this node is the last node).
@@ -305,6 +646,26 @@ class QueueHead : private Node<T>
                 flink->blink = node;
                 flink = node;
             }
+            nodeCount++;
+            Instrumentation::pushed(node, nodeCount);
+        }
+
+        //
+        //! @fn bool try_push_forward(Node<T>* node)
+        //  @brief Add the supplied node to the front of the queue, unless the queue is at its capacity.
+        //  @param node - The address of the node to be added to the beginning of the queue.
+        //  @return true - The node was added to the queue.
+        //  @return false - The queue is full, the node was not added.
+        //
+        bool
+        try_push_forward(Node<T>* node)
+        {
+            if (isFull())
+            {
+                return false;
+            }
+            push_forward(node);
+            return true;
         }
 
         //
@@ -329,6 +690,62 @@ class QueueHead : private Node<T>
                 blink->flink = node;
                 blink = node;
             }
+            nodeCount++;
+            Instrumentation::pushed(node, nodeCount);
+        }
+
+        //
+        //! @fn bool try_push_backward(Node<T>* node)
+        //  @brief Add the supplied node to the tail of the queue, unless the queue is at its capacity.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //  @return true - The node was added to the queue.
+        //  @return false - The queue is full, the node was not added.
+        //
+        bool
+        try_push_backward(Node<T>* node)
+        {
+            if (isFull())
+            {
+                return false;
+            }
+            push_backward(node);
+            return true;
+        }
+
+        //
+        //! @fn T& emplace_forward(Allocator& allocator, Args&&... args)
+        //  @brief Build a node, with its data constructed in place, and add it to the front of the queue.
+        //  @param allocator - The allocator from which the node is obtained (a NodePool, for example).
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return A reference to the data in the new node.
+        //
+        template <class Allocator, class... Args>
+        requires NodeAllocator<Allocator, T, Args...>
+        T&
+        emplace_forward(Allocator& allocator, Args&&... args)
+        {
+            Node<T>* node = allocator.emplace(std::forward<Args>(args)...);
+
+            push_forward(node);
+            return node->nodeData;
+        }
+
+        //
+        //! @fn T& emplace_backward(Allocator& allocator, Args&&... args)
+        //  @brief Build a node, with its data constructed in place, and add it to the tail of the queue.
+        //  @param allocator - The allocator from which the node is obtained (a NodePool, for example).
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return A reference to the data in the new node.
+        //
+        template <class Allocator, class... Args>
+        requires NodeAllocator<Allocator, T, Args...>
+        T&
+        emplace_backward(Allocator& allocator, Args&&... args)
+        {
+            Node<T>* node = allocator.emplace(std::forward<Args>(args)...);
+
+            push_backward(node);
+            return node->nodeData;
         }
 
         //
@@ -355,6 +772,8 @@ class QueueHead : private Node<T>
                 }
                 node->flink = node;
                 node->blink = node;
+                nodeCount--;
+                Instrumentation::popped(node);
                 return node;
             }
             return nullptr;
@@ -384,12 +803,455 @@ class QueueHead : private Node<T>
                 }
                 node->flink = node;
                 node->blink = node;
+                nodeCount--;
+                Instrumentation::popped(node);
                 return node;
             }
             return nullptr;
         }
 
+        //
+        //! @fn void push_forward(NodePool<T>& pool, T data)
+        //  @brief Construct a node from the pool and add it to the front of the queue.
+        //  @param pool - The pool from which the node is allocated.
+        //  @param data - The data to be stored in the new node.
+        //
+        void
+        push_forward(NodePool<T>& pool, T data)
+        {
+            push_forward(pool.allocate(std::move(data)));
+        }
+
+        //
+        //! @fn void push_backward(NodePool<T>& pool, T data)
+        //  @brief Construct a node from the pool and add it to the tail of the queue.
+        //  @param pool - The pool from which the node is allocated.
+        //  @param data - The data to be stored in the new node.
+        //
+        void
+        push_backward(NodePool<T>& pool, T data)
+        {
+            push_backward(pool.allocate(std::move(data)));
+        }
+
+        //
+        //! @fn bool pop_forward(NodePool<T>& pool, T& data)
+        //  @brief Remove the first node in the queue, move its data out and return the node to the pool.
+        //  @param pool - The pool to which the node is returned.
+        //  @param data - Receives the data from the node removed.
+        //  @return true - A node was removed and its data returned.
+        //  @return false - The queue is empty.
+        //
+        bool
+        pop_forward(NodePool<T>& pool, T& data)
+        {
+            Node<T>* node = pop_forward();
+
+            if (node != nullptr)
+            {
+                data = std::move(node->nodeData);
+                pool.deallocate(node);
+                return true;
+            }
+            return false;
+        }
+
+        //
+        //! @fn bool pop_backward(NodePool<T>& pool, T& data)
+        //  @brief Remove the last node in the queue, move its data out and return the node to the pool.
+        //  @param pool - The pool to which the node is returned.
+        //  @param data - Receives the data from the node removed.
+        //  @return true - A node was removed and its data returned.
+        //  @return false - The queue is empty.
+        //
+        bool
+        pop_backward(NodePool<T>& pool, T& data)
+        {
+            Node<T>* node = pop_backward();
+
+            if (node != nullptr)
+            {
+                data = std::move(node->nodeData);
+                pool.deallocate(node);
+                return true;
+            }
+            return false;
+        }
+
+        //
+        //! @fn void push_forward(Node<T>* first, Node<T>* last)
+        //  @brief Add a chain of nodes to the front of the queue.  The nodes from first to last must already be linked
+        //         to each other, such as a ring built with Node::insque, and must not be in a queue.  The chain is
+        //         walked once to count its nodes.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //
+        void
+        push_forward(Node<T>* first, Node<T>* last)
+        {
+            link_forward(first, last, chainLength(first, last));
+            pushedChain(first, last);
+        }
+
+        //
+        //! @fn void push_backward(Node<T>* first, Node<T>* last)
+        //  @brief Add a chain of nodes to the tail of the queue.  The nodes from first to last must already be linked
+        //         to each other, such as a ring built with Node::insque, and must not be in a queue.  The chain is
+        //         walked once to count its nodes.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //
+        void
+        push_backward(Node<T>* first, Node<T>* last)
+        {
+            link_backward(first, last, chainLength(first, last));
+            pushedChain(first, last);
+        }
+
+        //
+        //! @fn void splice_forward(QueueHead& other)
+        //  @brief Move all the nodes in the other queue to the front of this queue, leaving the other queue empty.
+        //  @param other - The queue whose nodes are moved.
+        //
+        void
+        splice_forward(QueueHead& other)
+        {
+            if ((&other != this) && !other.isEmpty())
+            {
+                link_forward(other.flink, other.blink, other.nodeCount);
+                other.flink = &other;
+                other.blink = &other;
+                other.nodeCount = 0;
+            }
+        }
+
+        //
+        //! @fn void splice_backward(QueueHead& other)
+        //  @brief Move all the nodes in the other queue to the tail of this queue, leaving the other queue empty.
+        //  @param other - The queue whose nodes are moved.
+        //
+        void
+        splice_backward(QueueHead& other)
+        {
+            if ((&other != this) && !other.isEmpty())
+            {
+                link_backward(other.flink, other.blink, other.nodeCount);
+                other.flink = &other;
+                other.blink = &other;
+                other.nodeCount = 0;
+            }
+        }
+
+        //
+        //! @fn size_type pop_forward_n(size_type n, QueueHead& batch)
+        //  @brief Remove up to the first n nodes in the queue and add them, in order, to the tail of the batch queue.
+        //  @param n - The maximum number of nodes to be removed.
+        //  @param batch - The queue receiving the nodes removed.
+        //  @return The number of nodes removed.
+        //
+        size_type
+        pop_forward_n(size_type n, QueueHead& batch)
+        {
+            if ((n == 0) || isEmpty() || (&batch == this))
+            {
+                return 0;
+            }
+            if (n >= nodeCount)
+            {
+                n = nodeCount;
+                batch.splice_backward(*this);
+                return n;
+            }
+
+            Node<T>* first = flink;
+            Node<T>* last = first;
+            size_type count = 1;
+
+            while ((count < n) && (last->flink != this))
+            {
+                last = last->flink;
+                count++;
+            }
+            if (last->flink == this)
+            {
+                flink = this;
+                blink = this;
+            }
+            else
+            {
+                flink = last->flink;
+                last->flink->blink = this;
+            }
+            nodeCount -= count;
+            batch.link_backward(first, last, count);
+            return count;
+        }
+
+        //
+        //! @fn Node<T>* insque(Node<T>* predecessor, Node<T>* node)
+        //  @brief Insert the supplied node after a node already in this queue, and count it.
+        //  @param predecessor - The node in this queue (or the header, see backward()) to insert after.
+        //  @param node - The address of the node to be inserted into the queue.
+        //  @retval The address of the node inserted.
+        //
+        Node<T>*
+        insque(Node<T>* predecessor, Node<T>* node)
+        {
+            predecessor->insque(node);
+            nodeCount++;
+            Instrumentation::pushed(node, nodeCount);
+            return node;
+        }
+
+        //
+        //! @fn Node<T>* remque(Node<T>* node)
+        //  @brief Remove the supplied node from this queue, and stop counting it.
+        //  @param node - The address of a node in this queue.
+        //  @retval The address of the node removed.
+        //
+        Node<T>*
+        remque(Node<T>* node)
+        {
+            node->remque();
+            nodeCount--;
+            Instrumentation::popped(node);
+            return node;
+        }
+
+        //
+        //! @fn iterator begin()
+        //  @brief Return an iterator to the first node in the queue.
+        //  @return An iterator to the first node (or end() if the queue is empty).
+        //
+        iterator
+        begin()
+        {
+            return iterator(flink);
+        }
+
+        //
+        //! @fn iterator end()
+        //  @brief Return an iterator to the header, which follows the last node in the queue.
+        //  @return An iterator to the header.
+        //
+        iterator
+        end()
+        {
+            return iterator(this);
+        }
+
+        //
+        //! @fn const_iterator begin() const
+        //  @brief Return a constant iterator to the first node in the queue.
+        //  @return A constant iterator to the first node (or end() if the queue is empty).
+        //
+        const_iterator
+        begin() const
+        {
+            return const_iterator(flink);
+        }
+
+        //
+        //! @fn const_iterator end() const
+        //  @brief Return a constant iterator to the header, which follows the last node in the queue.
+        //  @return A constant iterator to the header.
+        //
+        const_iterator
+        end() const
+        {
+            return const_iterator(const_cast<QueueHead*>(this));
+        }
+
+        //
+        //! @fn const_iterator cbegin() const
+        //  @brief Return a constant iterator to the first node in the queue.
+        //  @return A constant iterator to the first node (or end() if the queue is empty).
+        //
+        const_iterator
+        cbegin() const
+        {
+            return begin();
+        }
+
+        //
+        //! @fn const_iterator cend() const
+        //  @brief Return a constant iterator to the header, which follows the last node in the queue.
+        //  @return A constant iterator to the header.
+        //
+        const_iterator
+        cend() const
+        {
+            return end();
+        }
+
+        //
+        //! @fn reverse_iterator rbegin()
+        //  @brief Return a reverse iterator to the last node in the queue.
+        //  @return A reverse iterator to the last node.
+        //
+        reverse_iterator
+        rbegin()
+        {
+            return reverse_iterator(end());
+        }
+
+        //
+        //! @fn reverse_iterator rend()
+        //  @brief Return a reverse iterator that precedes the first node in the queue.
+        //  @return A reverse iterator to the header.
+        //
+        reverse_iterator
+        rend()
+        {
+            return reverse_iterator(begin());
+        }
+
+        //
+        //! @fn const_reverse_iterator rbegin() const
+        //  @brief Return a constant reverse iterator to the last node in the queue.
+        //  @return A constant reverse iterator to the last node.
+        //
+        const_reverse_iterator
+        rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+
+        //
+        //! @fn const_reverse_iterator rend() const
+        //  @brief Return a constant reverse iterator that precedes the first node in the queue.
+        //  @return A constant reverse iterator to the header.
+        //
+        const_reverse_iterator
+        rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        //
+        //! @fn iterator erase(const_iterator position)
+        //  @brief Remove the node at the supplied position from the queue.  The node is not destroyed, it remains owned
+        //         by the caller, who can get its address from position.node() first.
+        //  @param position - An iterator to the node to be removed (not end()).
+        //  @return An iterator to the node that followed the node removed.
+        //
+        iterator
+        erase(const_iterator position)
+        {
+            Node<T>* next = position.node()->flink;
+
+            remque(position.node());
+            return iterator(next);
+        }
+
+        //
+        //! @fn iterator insert(const_iterator position, Node<T>* node)
+        //  @brief Insert the supplied node in front of the node at the supplied position.
+        //  @param position - An iterator to the node the new node will precede (end() to add to the tail).
+        //  @param node - The address of the node to be inserted into the queue.
+        //  @return An iterator to the node inserted.
+        //
+        iterator
+        insert(const_iterator position, Node<T>* node)
+        {
+            return iterator(insque(position.node()->blink, node));
+        }
+
     private:
-        Node<T>* flink;             //!< Forward link to the first node in the queue (or the header).
-        Node<T>* blink;             //!< Backward link to the last node in the queue (or the header).
+
+        //
+        //! @fn size_type chainLength(Node<T>* first, Node<T>* last)
+        //  @brief Count the nodes in a chain.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //  @return The number of nodes from first to last.
+        //
+        static size_type
+        chainLength(Node<T>* first, Node<T>* last)
+        {
+            size_type count = 1;
+
+            for (Node<T>* node = first; node != last; node = node->flink)
+            {
+                count++;
+            }
+            return count;
+        }
+
+        //
+        //! @fn void pushedChain(Node<T>* first, Node<T>* last)
+        //  @brief Report each node of a chain just added to the queue to the instrumentation, if it is enabled.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //
+        void
+        pushedChain(Node<T>* first, Node<T>* last)
+        {
+            if constexpr (Instrumentation::enabled)
+            {
+                for (Node<T>* node = first; ; node = node->flink)
+                {
+                    Instrumentation::pushed(node, nodeCount);
+                    if (node == last)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        //
+        //! @fn void link_forward(Node<T>* first, Node<T>* last, size_type count)
+        //  @brief Link a chain of nodes in front of the first node in the queue.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //  @param count - The number of nodes in the chain.
+        //
+        void
+        link_forward(Node<T>* first, Node<T>* last, size_type count)
+        {
+            nodeCount += count;
+            first->blink = this;
+            if (isEmpty())
+            {
+                last->flink = this;
+                blink = last;
+            }
+            else
+            {
+                last->flink = flink;
+                flink->blink = last;
+            }
+            flink = first;
+        }
+
+        //
+        //! @fn void link_backward(Node<T>* first, Node<T>* last, size_type count)
+        //  @brief Link a chain of nodes after the last node in the queue.
+        //  @param first - The address of the first node in the chain.
+        //  @param last - The address of the last node in the chain.
+        //  @param count - The number of nodes in the chain.
+        //
+        void
+        link_backward(Node<T>* first, Node<T>* last, size_type count)
+        {
+            nodeCount += count;
+            last->flink = this;
+            if (isEmpty())
+            {
+                first->blink = this;
+                flink = first;
+            }
+            else
+            {
+                first->blink = blink;
+                blink->flink = first;
+            }
+            blink = last;
+        }
+
+        using Node<T>::flink;       //!< Forward link to the first node in the queue (or the header).
+        using Node<T>::blink;       //!< Backward link to the last node in the queue (or the header).
+        size_type nodeCount;        //!< The number of nodes in the queue.
+        size_type nodeCapacity;     //!< The number of nodes try_push_forward and try_push_backward will allow.
 };
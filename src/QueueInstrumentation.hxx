@@ -0,0 +1,387 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the class definitions of an instrumentation policy for the QueueHead and ShardedQueue, which
+//  records how long nodes wait in the queue and counts the operations on it.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+//
+//! @concept Timestamped
+//  @brief The data of a node that can be stamped with the time it was added to a queue, in nanoseconds.
+//
+template <class T>
+concept Timestamped = requires(T& data)
+{
+    { data.enqueueTime } -> std::convertible_to<std::uint64_t>;
+    data.enqueueTime = std::uint64_t(0);
+};
+
+//
+//! @class DwellHistogram
+//  @brief A log-linear histogram, in the style of an HDR histogram, of values from 0 to 2^64 - 1.  Each power of two
+//         is split into 32 buckets, so a value is reported to within about 3%.  Recording a value is a single relaxed
+//         atomic increment, and the percentiles can be read while values are being recorded.
+//  @note This class is thread-safe.
+//
+class DwellHistogram
+{
+    public:
+        static constexpr unsigned subBucketBits = 5;                            //!< log2 of buckets per power of two.
+        static constexpr std::size_t subBuckets = std::size_t(1) << subBucketBits;  //!< Buckets per power of two.
+        static constexpr std::size_t bucketCount = (65 - subBucketBits) << subBucketBits;   //!< Total buckets.
+
+        //
+        //! @fn void record(std::uint64_t value)
+        //  @brief Count a value.
+        //  @param value - The value to be counted.
+        //
+        void
+        record(std::uint64_t value)
+        {
+            counts[index(value)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //
+        //! @fn std::uint64_t count() const
+        //  @brief Return the number of values recorded.
+        //  @return The number of values.
+        //
+        std::uint64_t
+        count() const
+        {
+            std::uint64_t total = 0;
+
+            for (const std::atomic<std::uint64_t>& bucket : counts)
+            {
+                total += bucket.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        //
+        //! @fn std::uint64_t percentile(double fraction) const
+        //  @brief Return the value that the supplied fraction of the values recorded are at or below.
+        //  @param fraction - The fraction, 0.5 for the median, 0.999 for the 99.9th percentile.
+        //  @return The highest value in the bucket holding the percentile, zero if no values have been recorded.
+        //
+        std::uint64_t
+        percentile(double fraction) const
+        {
+            std::uint64_t total = count();
+            std::uint64_t rank = static_cast<std::uint64_t>(fraction * static_cast<double>(total) + 0.999999);
+            std::uint64_t seen = 0;
+
+            if (total == 0)
+            {
+                return 0;
+            }
+            rank = (rank == 0) ? 1 : ((rank > total) ? total : rank);
+            for (std::size_t ii = 0; ii < bucketCount; ii++)
+            {
+                seen += counts[ii].load(std::memory_order_relaxed);
+                if (seen >= rank)
+                {
+                    return highestEquivalent(ii);
+                }
+            }
+            return highestEquivalent(bucketCount - 1);
+        }
+
+        //
+        //! @fn std::size_t index(std::uint64_t value)
+        //  @brief Return the bucket for a value.  Values below 64 have a bucket each; above that, the top six bits of
+        //         the value select the bucket within its power of two.
+        //  @param value - The value.
+        //  @return The index of the bucket.
+        //
+        static constexpr std::size_t
+        index(std::uint64_t value)
+        {
+            int width = std::bit_width(value);
+            unsigned shift = (width > static_cast<int>(subBucketBits) + 1) ? width - subBucketBits - 1 : 0;
+
+            return (static_cast<std::size_t>(shift) << subBucketBits) + static_cast<std::size_t>(value >> shift);
+        }
+
+        //
+        //! @fn std::uint64_t highestEquivalent(std::size_t index)
+        //  @brief Return the highest value counted in a bucket.
+        //  @param index - The index of the bucket.
+        //  @return The highest value in the bucket.
+        //
+        static constexpr std::uint64_t
+        highestEquivalent(std::size_t index)
+        {
+            unsigned shift = (index < 2 * subBuckets) ? 0 : static_cast<unsigned>(index >> subBucketBits) - 1;
+            std::uint64_t mantissa = index - (static_cast<std::size_t>(shift) << subBucketBits);
+
+            return ((mantissa + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucketCount> counts{};  //!< The number of values in each bucket.
+};
+
+//
+//! @class QueueStats
+//  @brief The counters and dwell time histogram shared by every queue using the same LatencyInstrumentation.  The
+//         push, pop and steal counters are kept per thread, on their own cache lines, and summed when read.
+//  @note This class is thread-safe.  A snapshot can be taken while the queues are in use.
+//
+class QueueStats
+{
+    public:
+        static constexpr std::size_t threadSlots = 64;  //!< The number of per-thread counter sets.
+
+        //
+        //! @struct Snapshot
+        //  @brief The counters, and dwell time percentiles in nanoseconds, at the time of the snapshot.
+        //
+        struct Snapshot
+        {
+            std::uint64_t pushes;       //!< The number of nodes added.
+            std::uint64_t pops;         //!< The number of nodes removed.
+            std::uint64_t steals;       //!< The number of nodes stolen from another worker's queue.
+            std::uint64_t highWater;    //!< The most nodes any one queue has held.
+            std::uint64_t samples;      //!< The number of dwell times recorded.
+            std::uint64_t p50;          //!< The median dwell time.
+            std::uint64_t p99;          //!< The 99th percentile dwell time.
+            std::uint64_t p999;         //!< The 99.9th percentile dwell time.
+        };
+
+        //
+        //! @fn void pushed(std::size_t depth)
+        //  @brief Count a node added to a queue.
+        //  @param depth - The number of nodes now in the queue.
+        //
+        void
+        pushed(std::size_t depth)
+        {
+            std::uint64_t highest = highWater.load(std::memory_order_relaxed);
+
+            self().pushes.fetch_add(1, std::memory_order_relaxed);
+            while ((depth > highest) && !highWater.compare_exchange_weak(highest, depth, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        //
+        //! @fn void popped()
+        //  @brief Count a node removed from a queue.
+        //
+        void
+        popped()
+        {
+            self().pops.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //
+        //! @fn void popped(std::uint64_t dwell)
+        //  @brief Count a node removed from a queue, and record how long it was there.
+        //  @param dwell - The time the node was in the queue, in nanoseconds.
+        //
+        void
+        popped(std::uint64_t dwell)
+        {
+            self().pops.fetch_add(1, std::memory_order_relaxed);
+            dwellTimes.record(dwell);
+        }
+
+        //
+        //! @fn void stolen(std::size_t count)
+        //  @brief Count nodes stolen from another worker's queue.
+        //  @param count - The number of nodes stolen.
+        //
+        void
+        stolen(std::size_t count)
+        {
+            self().steals.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        //
+        //! @fn const DwellHistogram& histogram() const
+        //  @brief Return the histogram of dwell times, for percentiles other than those in a snapshot.
+        //  @return A reference to the histogram.
+        //
+        const DwellHistogram&
+        histogram() const
+        {
+            return dwellTimes;
+        }
+
+        //
+        //! @fn Snapshot snapshot() const
+        //  @brief Read the counters and dwell time percentiles without stopping the queues.
+        //  @return The snapshot.
+        //
+        Snapshot
+        snapshot() const
+        {
+            Snapshot result{};
+
+            for (const Counters& counters : perThread)
+            {
+                result.pushes += counters.pushes.load(std::memory_order_relaxed);
+                result.pops += counters.pops.load(std::memory_order_relaxed);
+                result.steals += counters.steals.load(std::memory_order_relaxed);
+            }
+            result.highWater = highWater.load(std::memory_order_relaxed);
+            result.samples = dwellTimes.count();
+            result.p50 = dwellTimes.percentile(0.5);
+            result.p99 = dwellTimes.percentile(0.99);
+            result.p999 = dwellTimes.percentile(0.999);
+            return result;
+        }
+
+    private:
+
+        //
+        //! @struct Counters
+        //  @brief The counters of one or more threads, on their own cache line.
+        //
+        struct alignas(64) Counters
+        {
+            std::atomic<std::uint64_t> pushes{0};   //!< The number of nodes added.
+            std::atomic<std::uint64_t> pops{0};     //!< The number of nodes removed.
+            std::atomic<std::uint64_t> steals{0};   //!< The number of nodes stolen.
+        };
+
+        //
+        //! @fn Counters& self()
+        //  @brief Return the counters of the calling thread.  Threads are given counter sets in turn, so threads only
+        //         share a set when there are more than threadSlots of them.
+        //  @return A reference to the counters.
+        //
+        Counters&
+        self()
+        {
+            static std::atomic<std::size_t> nextThread{0};
+            thread_local std::size_t slot = nextThread.fetch_add(1, std::memory_order_relaxed) % threadSlots;
+
+            return perThread[slot];
+        }
+
+        std::array<Counters, threadSlots> perThread{};  //!< The per-thread counters.
+        std::atomic<std::uint64_t> highWater{0};        //!< The most nodes any one queue has held.
+        DwellHistogram dwellTimes;                      //!< The time nodes spent in the queues.
+};
+
+//
+//! @class LatencyInstrumentation
+//  @brief An instrumentation policy for the QueueHead and ShardedQueue that counts pushes, pops and steals and keeps
+//         the high-water mark of the queue depth.  When the node data is Timestamped, the time is stored in it when
+//         the node is added, and the time the node waited is recorded when it is removed.  The policy has no state
+//         in the queue itself; all queues using the same Tag share one QueueStats.
+//  @tparam Tag Any type, used to give a group of queues its own statistics.
+//  @note This class is thread-safe.
+//
+template <class Tag = void>
+class LatencyInstrumentation
+{
+    public:
+        static constexpr bool enabled = true;       //!< Indicates the hooks do something.
+
+        //
+        //! @fn QueueStats& stats()
+        //  @brief Return the statistics of the queues using this policy.
+        //  @return A reference to the statistics.
+        //
+        static QueueStats&
+        stats()
+        {
+            return queueStats;
+        }
+
+        //
+        //! @fn void pushed(Node<T>* node, std::size_t depth)
+        //  @brief Stamp a node added to a queue with the time, and count it.
+        //  @param node - The address of the node added.
+        //  @param depth - The number of nodes now in the queue.
+        //
+        template <class T>
+        static void
+        pushed(Node<T>* node, std::size_t depth)
+        {
+            if constexpr (Timestamped<T>)
+            {
+                node->data().enqueueTime = now();
+            }
+            queueStats.pushed(depth);
+        }
+
+        //
+        //! @fn void popped(Node<T>* node)
+        //  @brief Count a node removed from a queue, and record the time since it was stamped.
+        //  @param node - The address of the node removed.
+        //
+        template <class T>
+        static void
+        popped(Node<T>* node)
+        {
+            if constexpr (Timestamped<T>)
+            {
+                queueStats.popped(now() - node->data().enqueueTime);
+            }
+            else
+            {
+                queueStats.popped();
+            }
+        }
+
+        //
+        //! @fn void stolen(std::size_t count)
+        //  @brief Count nodes stolen from another worker's queue.
+        //  @param count - The number of nodes stolen.
+        //
+        static void
+        stolen(std::size_t count)
+        {
+            queueStats.stolen(count);
+        }
+
+    private:
+
+        //
+        //! @fn std::uint64_t now()
+        //  @brief Return the time, in nanoseconds, from a clock that never goes backwards.
+        //  @return The current time.
+        //
+        static std::uint64_t
+        now()
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static inline QueueStats queueStats;        //!< The statistics of the queues using this policy.
+};
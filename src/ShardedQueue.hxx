@@ -0,0 +1,225 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definition of a set of per-worker queues that idle workers steal from.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added the instrumentation policy, which is also told about steals.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Publish the shard depths with release/acquire, and re-check every shard under its lock before a steal gives up.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+//
+//! @class ShardedQueue
+//  @brief A set of queues, one per worker.  A worker pushes and pops at the tail of its own shard, so shards only
+//         share a cache line when a worker runs out of work and steals.  A thief takes half of the nodes from the
+//         front of the first non-empty shard it finds, keeping one and moving the rest into its own shard, so a
+//         single steal rebalances many nodes.
+//  @tparam T The class of the data to be stored in the queue.
+//  @tparam Instrumentation The policy given to each shard's QueueHead, and told of each steal.
+//  @note This class is thread-safe, provided each shard is pushed to by only its own worker.  Each shard has its own
+//        lock, which is uncontended unless the shard is being stolen from.
+//
+template <class T, class Instrumentation = NoInstrumentation>
+class ShardedQueue
+{
+    public:
+        using size_type = typename QueueHead<T>::size_type;    //!< The type used for node counts.
+
+        //
+        //! @fn ShardedQueue(std::size_t shards)
+        //  @brief Constructor
+        //  @param shards - The number of shards (workers).
+        //
+        explicit ShardedQueue(std::size_t shards) :
+            shardTotal(shards),
+            shard(std::make_unique<Shard[]>(shards))
+        {}
+
+        //
+        //! @fn ~ShardedQueue()
+        //  @brief Default Destructor
+        //
+        ~ShardedQueue() = default;
+
+        //
+        //! @fn ShardedQueue(const ShardedQueue &)
+        //  @brief Disable the ability to copy this class via another ShardedQueue.
+        //  @param ShardedQueue A reference to a ShardedQueue.
+        //
+        ShardedQueue(const ShardedQueue&) = delete;
+
+        //
+        //! @fn ShardedQueue& operator=(ShardedQueue &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param ShardedQueue A reference to a ShardedQueue.
+        //  @retval ShardedQueue A reference to a ShardedQueue.
+        //
+        ShardedQueue&
+        operator=(const ShardedQueue&) = delete;
+
+        //
+        //! @fn std::size_t shardCount()
+        //  @brief Return the number of shards.
+        //  @return The number of shards.
+        //
+        std::size_t
+        shardCount()
+        {
+            return shardTotal;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in all the shards.  With other threads active, this is only a snapshot.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            size_type count = 0;
+
+            for (std::size_t ii = 0; ii < shardTotal; ii++)
+            {
+                count += shard[ii].depth.load(std::memory_order_relaxed);
+            }
+            return count;
+        }
+
+        //
+        //! @fn void push_backward(std::size_t owner, Node<T>* node)
+        //  @brief Add the supplied node to the tail of a worker's shard.
+        //  @param owner - The shard of the calling worker.
+        //  @param node - The address of the node to be added.
+        //
+        void
+        push_backward(std::size_t owner, Node<T>* node)
+        {
+            Shard& mine = shard[owner];
+            std::lock_guard<std::mutex> guard(mine.lock);
+
+            mine.queue.push_backward(node);
+            mine.depth.store(mine.queue.size(), std::memory_order_release);
+        }
+
+        //
+        //! @fn Node<T>* pop_backward(std::size_t owner)
+        //  @brief Remove the last node from a worker's shard, stealing from another shard if it is empty.
+        //  @param owner - The shard of the calling worker.
+        //  @return node - The address of the node removed.
+        //  @return nullptr - Every shard was found empty, under its lock, during the call.
+        //
+        Node<T>*
+        pop_backward(std::size_t owner)
+        {
+            Shard& mine = shard[owner];
+            {
+                std::lock_guard<std::mutex> guard(mine.lock);
+                Node<T>* node = mine.queue.pop_backward();
+
+                if (node != nullptr)
+                {
+                    mine.depth.store(mine.queue.size(), std::memory_order_release);
+                    return node;
+                }
+            }
+            return steal(owner);
+        }
+
+        //
+        //! @fn Node<T>* steal(std::size_t thief)
+        //  @brief Take half the nodes from the front of the next non-empty shard, keeping the first and moving the
+        //         rest to the tail of the thief's shard.
+        //  @param thief - The shard of the calling worker.
+        //  @return node - The address of the first node stolen.
+        //  @return nullptr - Every other shard was found empty, under its lock, during the call.
+        //
+        Node<T>*
+        steal(std::size_t thief)
+        {
+            QueueHead<T, Instrumentation> batch;
+
+            //
+            // The first pass skips the shards whose depth reads as zero without taking their locks.  That read can be
+            // out of date, so before giving up, a second pass looks at every shard under its lock.
+            //
+            for (int pass = 0; (pass < 2) && batch.isEmpty(); pass++)
+            {
+                for (std::size_t ii = 1; ii < shardTotal; ii++)
+                {
+                    Shard& victim = shard[(thief + ii) % shardTotal];
+
+                    if ((pass == 0) && (victim.depth.load(std::memory_order_acquire) == 0))
+                    {
+                        continue;
+                    }
+
+                    std::lock_guard<std::mutex> guard(victim.lock);
+
+                    size_type count = victim.queue.pop_forward_n((victim.queue.size() + 1) / 2, batch);
+
+                    if (count > 0)
+                    {
+                        victim.depth.store(victim.queue.size(), std::memory_order_release);
+                        Instrumentation::stolen(count);
+                        break;
+                    }
+                }
+            }
+
+            Node<T>* node = batch.pop_forward();
+
+            if (!batch.isEmpty())
+            {
+                Shard& mine = shard[thief];
+                std::lock_guard<std::mutex> guard(mine.lock);
+
+                mine.queue.splice_backward(batch);
+                mine.depth.store(mine.queue.size(), std::memory_order_release);
+            }
+            return node;
+        }
+
+    private:
+
+        //
+        //! @struct Shard
+        //  @brief The queue of a single worker, on its own cache lines.
+        //
+        struct alignas(64) Shard
+        {
+            std::mutex lock;                        //!< Protects the queue.
+            std::atomic<size_type> depth{0};        //!< The size of the queue, readable without the lock.
+            QueueHead<T, Instrumentation> queue;    //!< The nodes of this worker.
+        };
+
+        std::size_t shardTotal;                     //!< The number of shards.
+        std::unique_ptr<Shard[]> shard;             //!< The shards, one per worker.
+};
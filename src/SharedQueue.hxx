@@ -0,0 +1,684 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definitions to support a queue, and its nodes, that live in a region of
+//  memory shared between processes.  The links are offsets from the start of the region rather than pointers, so each
+//  process can map the region at a different address.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Unlink a newly created shared memory object if it cannot be mapped.
+//
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+template <class T> class SharedQueueHead;
+
+//
+//! @struct SharedNodeLinks
+//  @brief The forward and backward links of a SharedNode or SharedQueueHead, as offsets from the start of the region.
+//         An offset of zero refers to the SharedQueueHead, which is always at the start of the region.
+//
+struct SharedNodeLinks
+{
+    std::uint64_t flink;    //!< Offset of the next item in the queue.
+    std::uint64_t blink;    //!< Offset of the previous item in the queue.
+};
+
+//
+//! @class SharedNode
+//  @brief A node that lives in a shared region.  SharedNode items are only created by the SharedQueueHead of the region,
+//         and are returned to it when no longer needed.
+//  @tparam T Type of the data to be stored in a SharedNode.  It must be trivially copyable, and must not contain
+//          pointers, since they would not be meaningful in the other processes.
+//
+template <class T>
+class SharedNode : private SharedNodeLinks
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedNode data must be trivially copyable");
+
+    friend class SharedQueueHead<T>;
+
+    public:
+
+        //
+        //! @fn SharedNode(const SharedNode &)
+        //  @brief Disable the ability to copy this class via another SharedNode.
+        //  @param SharedNode A reference to a SharedNode.
+        //
+        SharedNode(const SharedNode&) = delete;
+
+        //
+        //! @fn SharedNode& operator=(SharedNode &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param SharedNode A reference to a SharedNode.
+        //  @retval SharedNode A reference to a SharedNode.
+        //
+        SharedNode&
+        operator=(const SharedNode&) = delete;
+
+        //
+        //! @fn T& data()
+        //  @brief Return a reference to the data, in the shared region, associated with this node.
+        //  @return A reference to the data stored in the node.
+        //
+        T&
+        data()
+        {
+            return nodeData;
+        }
+
+        //
+        //! @fn const T& data() const
+        //  @brief Return a const reference to the data, in the shared region, associated with this node.
+        //  @return A const reference to the data stored in the node.
+        //
+        const T&
+        data() const
+        {
+            return nodeData;
+        }
+
+    private:
+
+        //
+        //! @fn SharedNode()
+        //  @brief Default Constructor
+        //
+        SharedNode() = default;
+
+        T nodeData;             //!< The data stored in the node.
+};
+
+//
+//! @class SharedQueueHead
+//  @brief A header for a queue of SharedNode items, placed at the start of a shared region along with all the nodes it
+//         can ever hold.  One process formats the region with create(), and every other process maps the same region
+//         and calls attach().  A node allocated and filled in by one process can be pushed and then popped, and its
+//         data read in place, by another process, without copying.
+//  @tparam T Type of the data to be stored in the queue.
+//  @note This class is thread-safe, and process-safe.  It is protected by a spin lock in the region, since the lock has
+//        to work between processes.  A process that dies while holding the lock leaves the region unusable.
+//
+template <class T>
+class SharedQueueHead : private SharedNodeLinks
+{
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "The region lock must not need a separate lock");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The region magic must not need a separate lock");
+
+    public:
+        using size_type = std::uint64_t;                        //!< The type used for node counts.
+        static constexpr std::uint64_t regionMagic = 0x5354415851554555;    //!< Identifies a formatted region.
+        static constexpr std::uint32_t regionVersion = 1;       //!< The layout version of the region.
+        static constexpr std::size_t cacheLine = 64;            //!< The alignment of the first node.
+
+        //
+        //! @fn std::size_t regionSize(size_type nodes)
+        //  @brief Return the number of bytes needed for a region holding the supplied number of nodes.
+        //  @param nodes - The number of nodes the region is to hold.
+        //  @return The size of the region in bytes.
+        //
+        static constexpr std::size_t
+        regionSize(size_type nodes)
+        {
+            return firstNode() + (nodes * sizeof(SharedNode<T>));
+        }
+
+        //
+        //! @fn SharedQueueHead* create(void* region, std::size_t bytes)
+        //  @brief Format a region with an empty queue, and carve the rest of the region into free nodes.  This must be
+        //         done by exactly one process, before any other process attaches to the region.
+        //  @param region - The address at which the calling process has the region mapped.
+        //  @param bytes - The size of the region in bytes.
+        //  @return header - The address of the queue, at the start of the region.
+        //  @return nullptr - The region is too small to hold a single node.
+        //
+        static SharedQueueHead*
+        create(void* region, std::size_t bytes)
+        {
+            if (bytes < regionSize(1))
+            {
+                return nullptr;
+            }
+
+            SharedQueueHead* header = ::new (region) SharedQueueHead(bytes);
+
+            header->magic.store(regionMagic, std::memory_order_release);
+            return header;
+        }
+
+        //
+        //! @fn SharedQueueHead* attach(void* region)
+        //  @brief Return the queue in a region formatted by create(), possibly in another process.
+        //  @param region - The address at which the calling process has the region mapped.
+        //  @return header - The address of the queue, at the start of the region.
+        //  @return nullptr - The region is not formatted, or was formatted for a different type of node.
+        //
+        static SharedQueueHead*
+        attach(void* region)
+        {
+            SharedQueueHead* header = static_cast<SharedQueueHead*>(region);
+
+            if ((header->magic.load(std::memory_order_acquire) != regionMagic) ||
+                (header->version != regionVersion) ||
+                (header->nodeSize != sizeof(SharedNode<T>)))
+            {
+                return nullptr;
+            }
+            return header;
+        }
+
+        //
+        //! @fn SharedQueueHead(const SharedQueueHead &)
+        //  @brief Disable the ability to copy this class via another SharedQueueHead.
+        //  @param SharedQueueHead A reference to a SharedQueueHead.
+        //
+        SharedQueueHead(const SharedQueueHead&) = delete;
+
+        //
+        //! @fn SharedQueueHead& operator=(SharedQueueHead &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param SharedQueueHead A reference to a SharedQueueHead.
+        //  @retval SharedQueueHead A reference to a SharedQueueHead.
+        //
+        SharedQueueHead&
+        operator=(const SharedQueueHead&) = delete;
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that there are no nodes in the queue (the queue is empty).  With other threads
+        //         or processes active, this is only a snapshot.
+        //  @return true - There are no nodes currently in the queue.
+        //  @return false - There are is at least one node currently in the queue.
+        //
+        bool
+        isEmpty()
+        {
+            return size() == 0;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes in the queue.  With other threads or processes active, this is only a
+        //         snapshot.
+        //  @return The number of nodes currently in the queue.
+        //
+        size_type
+        size()
+        {
+            Guard guard(*this);
+
+            return nodeCount;
+        }
+
+        //
+        //! @fn size_type capacity()
+        //  @brief Return the total number of nodes in the region, whether queued, free or allocated.
+        //  @return The number of nodes carved from the region.
+        //
+        size_type
+        capacity()
+        {
+            return nodeTotal;
+        }
+
+        //
+        //! @fn SharedNode<T>* allocate()
+        //  @brief Take a node from the free nodes in the region.
+        //  @return node - The address of the node, mapped in the calling process.
+        //  @return nullptr - All the nodes in the region are in use.
+        //
+        SharedNode<T>*
+        allocate()
+        {
+            Guard guard(*this);
+
+            return take();
+        }
+
+        //
+        //! @fn void deallocate(SharedNode<T>* node)
+        //  @brief Return a node, which must not be in the queue, to the free nodes in the region.  It need not have
+        //         been allocated by the calling process.
+        //  @param node - The address of the node to be returned.
+        //
+        void
+        deallocate(SharedNode<T>* node)
+        {
+            Guard guard(*this);
+
+            node->flink = freeList;
+            freeList = offset(node);
+        }
+
+        //
+        //! @fn void push_forward(SharedNode<T>* node)
+        //  @brief Add the supplied node to the front of the queue.
+        //  @param node - The address of the node to be added to the front of the queue.
+        //
+        void
+        push_forward(SharedNode<T>* node)
+        {
+            Guard guard(*this);
+
+            link(0, node);
+        }
+
+        //
+        //! @fn void push_backward(SharedNode<T>* node)
+        //  @brief Add the supplied node to the tail of the queue.
+        //  @param node - The address of the node to be added to the end of the queue.
+        //
+        void
+        push_backward(SharedNode<T>* node)
+        {
+            Guard guard(*this);
+
+            link(blink, node);
+        }
+
+        //
+        //! @fn bool emplace_backward(Args&&... args)
+        //  @brief Take a free node, construct its data from the supplied arguments and add it to the tail of the
+        //         queue, all while holding the lock once.
+        //  @param args - The arguments forwarded to the constructor of T.
+        //  @return true - The node was added to the queue.
+        //  @return false - All the nodes in the region are in use.
+        //
+        template <class... Args>
+        bool
+        emplace_backward(Args&&... args)
+        {
+            Guard guard(*this);
+            SharedNode<T>* node = take();
+
+            if (node == nullptr)
+            {
+                return false;
+            }
+            ::new (static_cast<void*>(&node->nodeData)) T(std::forward<Args>(args)...);
+            link(blink, node);
+            return true;
+        }
+
+        //
+        //! @fn SharedNode<T>* pop_forward()
+        //  @brief Remove the first node in the queue.  The data can be read in place, after which the node should be
+        //         returned with deallocate() or pushed again.
+        //  @return node - The address of the node removed from the beginning of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        SharedNode<T>*
+        pop_forward()
+        {
+            Guard guard(*this);
+
+            return unlink(flink);
+        }
+
+        //
+        //! @fn SharedNode<T>* pop_backward()
+        //  @brief Remove the last node in the queue.
+        //  @return node - The address of the node removed from the end of the queue.
+        //  @return nullptr - The queue is empty.
+        //
+        SharedNode<T>*
+        pop_backward()
+        {
+            Guard guard(*this);
+
+            return unlink(blink);
+        }
+
+    private:
+
+        //
+        //! @struct Guard
+        //  @brief Holds the region lock for the life of the guard.
+        //
+        struct Guard
+        {
+            explicit Guard(SharedQueueHead& header) :
+                lock(header.lock)
+            {
+                while (lock.exchange(1, std::memory_order_acquire) != 0)
+                {
+                    while (lock.load(std::memory_order_relaxed) != 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            ~Guard()
+            {
+                lock.store(0, std::memory_order_release);
+            }
+
+            std::atomic<std::uint32_t>& lock;       //!< The lock in the region.
+        };
+
+        //
+        //! @fn SharedQueueHead(std::size_t bytes)
+        //  @brief Constructor, only called by create().
+        //  @param bytes - The size of the region in bytes.
+        //
+        explicit SharedQueueHead(std::size_t bytes) :
+            SharedNodeLinks{0, 0},
+            magic(0),
+            version(regionVersion),
+            nodeSize(sizeof(SharedNode<T>)),
+            lock(0),
+            nodeCount(0),
+            nodeTotal((bytes - firstNode()) / sizeof(SharedNode<T>)),
+            freeList(0)
+        {
+            for (size_type ii = nodeTotal; ii > 0; ii--)
+            {
+                SharedNode<T>* node = ::new (base() + firstNode() + ((ii - 1) * sizeof(SharedNode<T>))) SharedNode<T>;
+
+                node->flink = freeList;
+                freeList = offset(node);
+            }
+        }
+
+        //
+        //! @fn std::size_t firstNode()
+        //  @brief Return the offset of the first node in the region, which is on its own cache line.
+        //  @return The offset of the first node.
+        //
+        static constexpr std::size_t
+        firstNode()
+        {
+            return ((sizeof(SharedQueueHead) + cacheLine - 1) / cacheLine) * cacheLine;
+        }
+
+        //
+        //! @fn char* base()
+        //  @brief Return the start of the region, as mapped in the calling process.
+        //  @return The address of the region.
+        //
+        char*
+        base()
+        {
+            return reinterpret_cast<char*>(this);
+        }
+
+        //
+        //! @fn std::uint64_t offset(SharedNode<T>* node)
+        //  @brief Convert the address of a node in the calling process to its offset in the region.
+        //  @param node - The address of the node.
+        //  @return The offset of the node's links.
+        //
+        std::uint64_t
+        offset(SharedNode<T>* node)
+        {
+            return reinterpret_cast<char*>(static_cast<SharedNodeLinks*>(node)) - base();
+        }
+
+        //
+        //! @fn SharedNodeLinks& at(std::uint64_t where)
+        //  @brief Convert an offset in the region to the links at that offset in the calling process.
+        //  @param where - The offset of the links.
+        //  @return The links of the node, or of the header when the offset is zero.
+        //
+        SharedNodeLinks&
+        at(std::uint64_t where)
+        {
+            return *reinterpret_cast<SharedNodeLinks*>(base() + where);
+        }
+
+        //
+        //! @fn SharedNode<T>* take()
+        //  @brief Remove the first free node, with the lock held.
+        //  @return node - The address of the node.
+        //  @return nullptr - There are no free nodes.
+        //
+        SharedNode<T>*
+        take()
+        {
+            if (freeList == 0)
+            {
+                return nullptr;
+            }
+
+            SharedNode<T>* node = static_cast<SharedNode<T>*>(&at(freeList));
+
+            freeList = node->flink;
+            return node;
+        }
+
+        //
+        //! @fn void link(std::uint64_t pred, SharedNode<T>* node)
+        //  @brief Insert a node after the supplied item, with the lock held.
+        //  @param pred - The offset of the item the node goes after.
+        //  @param node - The address of the node being inserted.
+        //
+        void
+        link(std::uint64_t pred, SharedNode<T>* node)
+        {
+            std::uint64_t where = offset(node);
+            SharedNodeLinks& before = at(pred);
+
+            node->flink = before.flink;
+            node->blink = pred;
+            at(before.flink).blink = where;
+            before.flink = where;
+            nodeCount++;
+        }
+
+        //
+        //! @fn SharedNode<T>* unlink(std::uint64_t where)
+        //  @brief Remove the node at the supplied offset, with the lock held.
+        //  @param where - The offset of the node, zero if the queue is empty.
+        //  @return node - The address of the node removed.
+        //  @return nullptr - The queue is empty.
+        //
+        SharedNode<T>*
+        unlink(std::uint64_t where)
+        {
+            if (where == 0)
+            {
+                return nullptr;
+            }
+
+            SharedNode<T>* node = static_cast<SharedNode<T>*>(&at(where));
+
+            at(node->blink).flink = node->flink;
+            at(node->flink).blink = node->blink;
+            node->flink = where;
+            node->blink = where;
+            nodeCount--;
+            return node;
+        }
+
+        std::atomic<std::uint64_t> magic;           //!< Set to regionMagic once the region is formatted.
+        std::uint32_t version;                      //!< The layout version of the region.
+        std::uint32_t nodeSize;                     //!< The size of each node, to catch a mismatched T.
+        std::atomic<std::uint32_t> lock;            //!< Non-zero while a thread in any process holds the lock.
+        size_type nodeCount;                        //!< The number of nodes in the queue.
+        size_type nodeTotal;                        //!< The number of nodes carved from the region.
+        std::uint64_t freeList;                     //!< The offset of the first free node, zero if there are none.
+};
+
+//
+//! @class SharedMemory
+//  @brief Maps a POSIX shared memory object into the calling process, unmapping it when destroyed.
+//  @note The constructors throw std::system_error if the object cannot be created, opened or mapped.
+//
+class SharedMemory
+{
+    public:
+
+        //
+        //! @fn SharedMemory(const std::string& name, std::size_t bytes)
+        //  @brief Constructor, which creates a new shared memory object and maps it.
+        //  @param name - The name of the object, starting with a '/'.  It must not already exist.
+        //  @param bytes - The size of the object in bytes.
+        //
+        SharedMemory(const std::string& name, std::size_t bytes) :
+            regionBytes(bytes)
+        {
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+            }
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+            {
+                int error = errno;
+
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+            }
+            map(fd, name, true);
+        }
+
+        //
+        //! @fn SharedMemory(const std::string& name)
+        //  @brief Constructor, which maps an existing shared memory object, normally created by another process.
+        //  @param name - The name of the object, starting with a '/'.
+        //
+        explicit SharedMemory(const std::string& name)
+        {
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            struct stat status;
+
+            if (fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+            }
+            if (::fstat(fd, &status) != 0)
+            {
+                int error = errno;
+
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat " + name);
+            }
+            regionBytes = static_cast<std::size_t>(status.st_size);
+            map(fd, name, false);
+        }
+
+        //
+        //! @fn ~SharedMemory()
+        //  @brief Destructor, which unmaps the object.  The object itself remains until it is unlinked.
+        //
+        ~SharedMemory()
+        {
+            ::munmap(region, regionBytes);
+        }
+
+        //
+        //! @fn SharedMemory(const SharedMemory &)
+        //  @brief Disable the ability to copy this class via another SharedMemory.
+        //  @param SharedMemory A reference to a SharedMemory.
+        //
+        SharedMemory(const SharedMemory&) = delete;
+
+        //
+        //! @fn SharedMemory& operator=(SharedMemory &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param SharedMemory A reference to a SharedMemory.
+        //  @retval SharedMemory A reference to a SharedMemory.
+        //
+        SharedMemory&
+        operator=(const SharedMemory&) = delete;
+
+        //
+        //! @fn void unlink(const std::string& name)
+        //  @brief Remove the name of a shared memory object.  Processes that have it mapped can continue to use it.
+        //  @param name - The name of the object.
+        //
+        static void
+        unlink(const std::string& name)
+        {
+            ::shm_unlink(name.c_str());
+        }
+
+        //
+        //! @fn void* address()
+        //  @brief Return the address at which the object is mapped in the calling process.
+        //  @return The address of the region.
+        //
+        void*
+        address()
+        {
+            return region;
+        }
+
+        //
+        //! @fn std::size_t size()
+        //  @brief Return the size of the object.
+        //  @return The size of the region in bytes.
+        //
+        std::size_t
+        size()
+        {
+            return regionBytes;
+        }
+
+    private:
+
+        //
+        //! @fn void map(int fd, const std::string& name, bool created)
+        //  @brief Map the open object and close the descriptor, which the mapping does not need.
+        //  @param fd - The descriptor of the object.
+        //  @param name - The name of the object, for error reporting.
+        //  @param created - Indicates this process created the object, so it is unlinked if it cannot be mapped.
+        //
+        void
+        map(int fd, const std::string& name, bool created)
+        {
+            region = ::mmap(nullptr, regionBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+            int error = errno;
+
+            ::close(fd);
+            if (region == MAP_FAILED)
+            {
+                region = nullptr;
+                if (created)
+                {
+                    ::shm_unlink(name.c_str());
+                }
+                throw std::system_error(error, std::generic_category(), "mmap " + name);
+            }
+        }
+
+        void* region = nullptr;                     //!< The address of the mapping.
+        std::size_t regionBytes = 0;                //!< The size of the mapping.
+};
@@ -0,0 +1,389 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the template class definition of a hierarchical timing wheel, which hands back Node items once
+//  their deadline has passed.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Documented that nodes already due when scheduled are returned in the order they were scheduled.
+//
+#pragma once
+
+#include "Queue.hxx"
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+//
+//! @concept HasDeadline
+//  @brief The data of a node that can be scheduled on a TimingWheel, which stores the deadline in it.
+//
+template <class T>
+concept HasDeadline = requires(T& data)
+{
+    { data.deadline } -> std::convertible_to<std::uint64_t>;
+    data.deadline = std::uint64_t(0);
+};
+
+//
+//! @class TimingWheel
+//  @brief A hierarchical timing wheel of Node items.  Level 0 has a bucket per tick, and each level above it has a
+//         bucket per rotation of the level below.  A node goes in the bucket of the highest digit (of SlotBits bits)
+//         in which its deadline differs from the current tick, and moves down a level each time the wheel reaches that
+//         bucket, until it reaches level 0 and expires.  Deadlines beyond the top level wait in an overflow list that
+//         is sorted into the wheel each time the top level completes a rotation.
+//
+//         Each bucket is a QueueHead, and nodes are added with Node::insque and cancelled with Node::remque, so
+//         schedule and cancel are O(1) and cancel does not need to know which bucket the node is in.  The wheel keeps
+//         its own count of the nodes scheduled; the counts of the buckets are not used.  A bitmap of the buckets in
+//         use lets advance() go straight to the next bucket with anything in it, however far time has moved.
+//  @tparam T The class of the data in the nodes, which must satisfy HasDeadline.
+//  @tparam Levels The number of levels.
+//  @tparam SlotBits log2 of the number of buckets in each level.  The wheel covers 2^(Levels * SlotBits) ticks.
+//  @note This class is not thread-safe.  The unit of a tick is up to the caller.
+//
+template <HasDeadline T, std::size_t Levels = 4, unsigned SlotBits = 8>
+class TimingWheel
+{
+    static_assert((Levels >= 1) && (SlotBits >= 1) && ((Levels * SlotBits) < 64), "The wheel must fit in 64 bits");
+
+    public:
+        using size_type = typename QueueHead<T>::size_type;    //!< The type used for node counts.
+        static constexpr std::size_t slots = std::size_t(1) << SlotBits;    //!< The number of buckets in each level.
+
+        //
+        //! @fn TimingWheel(std::uint64_t start)
+        //  @brief Constructor
+        //  @param start - The current tick.
+        //
+        explicit TimingWheel(std::uint64_t start = 0) :
+            current(start),
+            timerCount(0)
+        {}
+
+        //
+        //! @fn ~TimingWheel()
+        //  @brief Default Destructor.  Nodes still scheduled remain owned by the caller.
+        //
+        ~TimingWheel() = default;
+
+        //
+        //! @fn TimingWheel(const TimingWheel &)
+        //  @brief Disable the ability to copy this class via another TimingWheel.
+        //  @param TimingWheel A reference to a TimingWheel.
+        //
+        TimingWheel(const TimingWheel&) = delete;
+
+        //
+        //! @fn TimingWheel& operator=(TimingWheel &)
+        //  @brief Disable the ability to copy this class via the equal operator.
+        //  @param TimingWheel A reference to a TimingWheel.
+        //  @retval TimingWheel A reference to a TimingWheel.
+        //
+        TimingWheel&
+        operator=(const TimingWheel&) = delete;
+
+        //
+        //! @fn std::uint64_t now()
+        //  @brief Return the current tick, which is the latest tick passed to advance().
+        //  @return The current tick.
+        //
+        std::uint64_t
+        now()
+        {
+            return current;
+        }
+
+        //
+        //! @fn bool isEmpty()
+        //  @brief Return an indicator that no nodes are scheduled.
+        //  @return true - There are no nodes scheduled.
+        //  @return false - There is at least one node scheduled.
+        //
+        bool
+        isEmpty()
+        {
+            return timerCount == 0;
+        }
+
+        //
+        //! @fn size_type size()
+        //  @brief Return the number of nodes scheduled, including those due but not yet returned by advance().
+        //  @return The number of nodes scheduled.
+        //
+        size_type
+        size()
+        {
+            return timerCount;
+        }
+
+        //
+        //! @fn void schedule(Node<T>* node, std::uint64_t deadline)
+        //  @brief Schedule a node, which must not be in a queue, to be returned by advance() once the deadline has been
+        //         reached.  A deadline at or before the current tick is returned by the next advance(), ahead of the
+        //         nodes that expire during it, in the order such nodes were scheduled.
+        //  @param node - The address of the node to be scheduled.
+        //  @param deadline - The tick at which the node expires.
+        //
+        void
+        schedule(Node<T>* node, std::uint64_t deadline)
+        {
+            node->data().deadline = deadline;
+            place(node);
+            timerCount++;
+        }
+
+        //
+        //! @fn void cancel(Node<T>* node)
+        //  @brief Remove a scheduled node from the wheel, wherever it is.
+        //  @param node - The address of a node that is scheduled and has not been returned by advance().
+        //
+        void
+        cancel(Node<T>* node)
+        {
+            node->remque();
+            timerCount--;
+        }
+
+        //
+        //! @fn size_type advance(std::uint64_t now, QueueHead<T>& expired)
+        //  @brief Move the current tick forward, and add every node whose deadline has been reached to the tail of the
+        //         expired queue.  Nodes that were scheduled with a deadline already at or before the current tick come
+        //         first, in the order they were scheduled, not sorted by deadline; the rest follow in order of
+        //         deadline.  The buckets are spliced together and added as one chain.  Empty stretches of the wheel are
+        //         skipped, so the cost depends on the nodes expiring and moving down a level, not on the number of
+        //         ticks.
+        //  @param now - The new current tick.  If it is not after the current tick, only nodes already due are added.
+        //  @param expired - The queue receiving the nodes whose deadline has been reached.
+        //  @return The number of nodes added to the expired queue.
+        //
+        size_type
+        advance(std::uint64_t now, QueueHead<T>& expired)
+        {
+            QueueHead<T> drained;
+
+            drained.splice_backward(due);
+            while (current < now)
+            {
+                current = nextEvent(now);
+                if (!overflow.isEmpty() && ((current & lowerTicks(Levels)) == 0))
+                {
+                    replace(overflow);
+                }
+                for (std::size_t level = Levels - 1; level > 0; level--)
+                {
+                    if ((current & lowerTicks(level)) == 0)
+                    {
+                        replace(take(level, digit(current, level)));
+                    }
+                }
+                drained.splice_backward(due);
+                drained.splice_backward(take(0, digit(current, 0)));
+            }
+            if (drained.isEmpty())
+            {
+                return 0;
+            }
+
+            size_type before = expired.size();
+
+            expired.push_backward(drained.forward(), drained.backward());
+
+            size_type count = expired.size() - before;
+
+            timerCount -= count;
+            return count;
+        }
+
+    private:
+        static constexpr std::uint64_t slotMask = slots - 1;                //!< Selects a digit.
+        static constexpr std::size_t words = (slots + 63) / 64;             //!< The words in each level's bitmap.
+
+        //
+        //! @fn std::uint64_t lowerTicks(std::size_t level)
+        //  @brief Return a mask of the digits below a level.
+        //  @param level - The level.
+        //  @return The mask of the lower digits.
+        //
+        static constexpr std::uint64_t
+        lowerTicks(std::size_t level)
+        {
+            return (std::uint64_t(1) << (level * SlotBits)) - 1;
+        }
+
+        //
+        //! @fn std::size_t digit(std::uint64_t tick, std::size_t level)
+        //  @brief Return the digit of a tick at a level, which is the bucket for that tick at that level.
+        //  @param tick - The tick.
+        //  @param level - The level.
+        //  @return The digit.
+        //
+        static constexpr std::size_t
+        digit(std::uint64_t tick, std::size_t level)
+        {
+            return static_cast<std::size_t>((tick >> (level * SlotBits)) & slotMask);
+        }
+
+        //
+        //! @fn void append(QueueHead<T>& bucket, Node<T>* node)
+        //  @brief Add a node to the tail of a bucket without counting it.
+        //  @param bucket - The bucket.
+        //  @param node - The address of the node.
+        //
+        static void
+        append(QueueHead<T>& bucket, Node<T>* node)
+        {
+            bucket.backward()->insque(node);
+        }
+
+        //
+        //! @fn void place(Node<T>* node)
+        //  @brief Put a node in the bucket for its deadline, relative to the current tick.
+        //  @param node - The address of the node.
+        //
+        void
+        place(Node<T>* node)
+        {
+            std::uint64_t deadline = node->data().deadline;
+
+            if (deadline <= current)
+            {
+                append(due, node);
+                return;
+            }
+
+            std::size_t level = (std::bit_width(deadline ^ current) - 1) / SlotBits;
+
+            if (level >= Levels)
+            {
+                append(overflow, node);
+                return;
+            }
+
+            std::size_t slot = digit(deadline, level);
+
+            append(wheel[level][slot], node);
+            occupied[level][slot / 64] |= std::uint64_t(1) << (slot % 64);
+        }
+
+        //
+        //! @fn QueueHead<T>& take(std::size_t level, std::size_t slot)
+        //  @brief Return a bucket that the wheel has reached, marking it as no longer in use.
+        //  @param level - The level of the bucket.
+        //  @param slot - The position of the bucket in the level.
+        //  @return A reference to the bucket.
+        //
+        QueueHead<T>&
+        take(std::size_t level, std::size_t slot)
+        {
+            occupied[level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+            return wheel[level][slot];
+        }
+
+        //
+        //! @fn void replace(QueueHead<T>& bucket)
+        //  @brief Move every node in a bucket to the bucket for its deadline, relative to the current tick.
+        //  @param bucket - The bucket being emptied.
+        //
+        void
+        replace(QueueHead<T>& bucket)
+        {
+            QueueHead<T> moving;
+
+            moving.splice_backward(bucket);
+            while (!moving.isEmpty())
+            {
+                Node<T>* node = moving.forward();
+
+                node->remque();
+                place(node);
+            }
+        }
+
+        //
+        //! @fn std::size_t nextSlot(std::size_t level, std::size_t from)
+        //  @brief Return the first bucket in use in a level, at or after the supplied position.
+        //  @param level - The level.
+        //  @param from - The first position to look at.
+        //  @return The position of the bucket, or slots if there is none.
+        //
+        std::size_t
+        nextSlot(std::size_t level, std::size_t from)
+        {
+            for (std::size_t word = from / 64; word < words; word++)
+            {
+                std::uint64_t bits = occupied[level][word];
+
+                if (word == from / 64)
+                {
+                    bits &= ~std::uint64_t(0) << (from % 64);
+                }
+                if (bits != 0)
+                {
+                    return (word * 64) + std::countr_zero(bits);
+                }
+            }
+            return slots;
+        }
+
+        //
+        //! @fn std::uint64_t nextEvent(std::uint64_t now)
+        //  @brief Return the next tick at which a bucket in use is reached, or the overflow list has to be sorted into
+        //         the wheel, but no later than the supplied tick.
+        //  @param now - The tick being advanced to.
+        //  @return The tick at which the wheel next has work to do.
+        //
+        std::uint64_t
+        nextEvent(std::uint64_t now)
+        {
+            std::uint64_t next = now;
+
+            for (std::size_t level = 0; level < Levels; level++)
+            {
+                std::size_t slot = nextSlot(level, digit(current, level) + 1);
+
+                if (slot < slots)
+                {
+                    std::uint64_t tick = (current & ~lowerTicks(level + 1)) |
+                                         (static_cast<std::uint64_t>(slot) << (level * SlotBits));
+
+                    next = (tick < next) ? tick : next;
+                }
+            }
+            if (!overflow.isEmpty())
+            {
+                std::uint64_t tick = (current | lowerTicks(Levels)) + 1;
+
+                next = (tick < next) ? tick : next;
+            }
+            return next;
+        }
+
+        std::array<std::array<QueueHead<T>, slots>, Levels> wheel;          //!< The buckets.
+        std::array<std::array<std::uint64_t, words>, Levels> occupied{};    //!< The buckets that may be in use.
+        QueueHead<T> due;                           //!< Nodes scheduled at or before the current tick.
+        QueueHead<T> overflow;                      //!< Nodes beyond the top level.
+        std::uint64_t current;                      //!< The current tick.
+        size_type timerCount;                       //!< The number of nodes scheduled.
+};
@@ -0,0 +1,601 @@
+//
+// Copyright (C) Jonathan D. Belanger 2024.
+// All Rights Reserved.
+//
+// This software is furnished under a license and may be used and copied only in accordance with the terms of such
+// license and with the inclusion of the above copyright notice.  This software or any other copies thereof may not be
+// provided or otherwise made available to any other person.  No title to and ownership of the software is hereby
+// transferred.
+//
+// The information in this software is subject to change without notice and should not be construed as a commitment by
+// the author or co-authors.
+//
+// The author and any co-authors assume no responsibility for the use or reliability of this software.
+//
+// Description:
+//
+//! @file
+//  This file contains the microbenchmarks for the Queue functionality.  Run with --benchmark_format=json (or the
+//  QueueBenchJson target) for machine-readable results.
+//
+// Revision History:
+//
+//  V01.000 16-Oct-2026 Jonathan D. Belanger
+//  Initially written.
+//
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added the PersistentQueueHead group commit and recovery benchmarks.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Added the instrumented push/pop benchmark.
+//
+//  V01.003 16-Oct-2026 Jonathan D. Belanger
+//  Added the ChunkedQueueHead benchmarks, and the memory used per element by the traversal benchmarks.
+//
+//  V01.004 16-Oct-2026 Jonathan D. Belanger
+//  Added the TimingWheel benchmarks.
+//
+//  V01.005 16-Oct-2026 Jonathan D. Belanger
+//  Recovery is measured from 64K to 1M nodes unless QUEUEBENCH_LARGE_RECOVERY is set.
+//
+#include "Queue.hxx"
+#include "ConcurrentQueue.hxx"
+#include "NodePool.hxx"
+#include "ShardedQueue.hxx"
+#include "PersistentQueue.hxx"
+#include "QueueInstrumentation.hxx"
+#include "ChunkedQueue.hxx"
+#include "TimingWheel.hxx"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//
+// A payload of a fixed number of bytes.
+//
+template <std::size_t Bytes>
+struct Payload
+{
+    unsigned char bytes[Bytes] = {};
+};
+
+//
+// Single thread push_backward/pop_forward of a node that is already allocated.
+//
+static void
+BM_QueueHeadPushPop(benchmark::State &state)
+{
+    QueueHead<int> header;
+    Node<int> node(42);
+
+    for (auto _ : state)
+    {
+        header.push_backward(&node);
+        benchmark::DoNotOptimize(header.pop_forward());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueueHeadPushPop);
+
+//
+// The same, with every push stamped and every pop recorded in the dwell time histogram.
+//
+struct TimedPayload
+{
+    std::uint64_t id;
+    std::uint64_t enqueueTime;
+};
+
+static void
+BM_InstrumentedPushPop(benchmark::State &state)
+{
+    QueueHead<TimedPayload, LatencyInstrumentation<TimedPayload>> header;
+    Node<TimedPayload> node(TimedPayload{42, 0});
+
+    for (auto _ : state)
+    {
+        header.push_backward(&node);
+        benchmark::DoNotOptimize(header.pop_forward());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InstrumentedPushPop);
+
+//
+// Single thread push_backward/pop_forward against a queue that already holds a number of nodes.
+//
+static void
+BM_QueueHeadPushPopDeep(benchmark::State &state)
+{
+    NodePool<int> pool;
+    QueueHead<int> header;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        header.push_backward(pool.allocate(static_cast<int>(ii)));
+    }
+    for (auto _ : state)
+    {
+        header.push_backward(header.pop_forward());
+    }
+    state.SetItemsProcessed(state.iterations());
+    while (!header.isEmpty())
+    {
+        pool.deallocate(header.pop_forward());
+    }
+}
+BENCHMARK(BM_QueueHeadPushPopDeep)->RangeMultiplier(100)->Range(10, 100000);
+
+//
+// Full forward traversal of queues of increasing depth.
+//
+static void
+BM_QueueHeadTraverse(benchmark::State &state)
+{
+    NodePool<int> pool(4096, 256);
+    QueueHead<int> header;
+    long long sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        header.push_backward(pool.allocate(static_cast<int>(ii)));
+    }
+    for (auto _ : state)
+    {
+        for (int data : header)
+        {
+            sum += data;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] = sizeof(Node<int>);
+    while (!header.isEmpty())
+    {
+        pool.deallocate(header.pop_forward());
+    }
+}
+BENCHMARK(BM_QueueHeadTraverse)->RangeMultiplier(10)->Range(10, 10000000);
+
+static void
+BM_ChunkedTraverse(benchmark::State &state)
+{
+    ChunkedQueueHead<int> header;
+    long long sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        header.push_backward(static_cast<int>(ii));
+    }
+    for (auto _ : state)
+    {
+        for (int data : header)
+        {
+            sum += data;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] =
+        static_cast<double>(header.chunkCount() * header.chunkBytes()) / static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_ChunkedTraverse)->RangeMultiplier(10)->Range(10, 10000000);
+
+//
+// Full forward traversal of 16 byte payment identifiers, one per Node from a NodePool, and in chunks.
+//
+struct PaymentId
+{
+    std::uint64_t high;
+    std::uint64_t low;
+};
+
+static void
+BM_QueueHeadTraverseId(benchmark::State &state)
+{
+    NodePool<PaymentId> pool(4096, 256);
+    QueueHead<PaymentId> header;
+    std::uint64_t sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        header.push_backward(pool.allocate(PaymentId{0, static_cast<std::uint64_t>(ii)}));
+    }
+    for (auto _ : state)
+    {
+        for (const PaymentId &data : header)
+        {
+            sum += data.low;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] = sizeof(Node<PaymentId>);
+    while (!header.isEmpty())
+    {
+        pool.deallocate(header.pop_forward());
+    }
+}
+BENCHMARK(BM_QueueHeadTraverseId)->RangeMultiplier(100)->Range(100, 1000000);
+
+static void
+BM_ChunkedTraverseId(benchmark::State &state)
+{
+    ChunkedQueueHead<PaymentId> header;
+    std::uint64_t sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        header.push_backward(PaymentId{0, static_cast<std::uint64_t>(ii)});
+    }
+    for (auto _ : state)
+    {
+        for (const PaymentId &data : header)
+        {
+            sum += data.low;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_element"] =
+        static_cast<double>(header.chunkCount() * header.chunkBytes()) / static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_ChunkedTraverseId)->RangeMultiplier(100)->Range(100, 1000000);
+
+static void
+BM_DequeTraverse(benchmark::State &state)
+{
+    std::deque<int> queue;
+    long long sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        queue.push_back(static_cast<int>(ii));
+    }
+    for (auto _ : state)
+    {
+        for (int data : queue)
+        {
+            sum += data;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DequeTraverse)->RangeMultiplier(10)->Range(10, 10000000);
+
+static void
+BM_ListTraverse(benchmark::State &state)
+{
+    std::list<int> queue;
+    long long sum = 0;
+
+    for (int64_t ii = 0; ii < state.range(0); ii++)
+    {
+        queue.push_back(static_cast<int>(ii));
+    }
+    for (auto _ : state)
+    {
+        for (int data : queue)
+        {
+            sum += data;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ListTraverse)->RangeMultiplier(10)->Range(10, 10000000);
+
+//
+// Enqueue and dequeue, including building and destroying the node, for payloads of different sizes and with the
+// different ways of getting a node.
+//
+template <std::size_t Bytes>
+static void
+BM_PayloadNew(benchmark::State &state)
+{
+    QueueHead<Payload<Bytes>> header;
+
+    for (auto _ : state)
+    {
+        header.push_backward(new Node<Payload<Bytes>>(std::in_place));
+        delete header.pop_forward();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_PayloadNew, 16);
+BENCHMARK_TEMPLATE(BM_PayloadNew, 64);
+BENCHMARK_TEMPLATE(BM_PayloadNew, 256);
+BENCHMARK_TEMPLATE(BM_PayloadNew, 1024);
+
+template <std::size_t Bytes>
+static void
+BM_PayloadNodePool(benchmark::State &state)
+{
+    NodePool<Payload<Bytes>> pool;
+    QueueHead<Payload<Bytes>> header;
+
+    for (auto _ : state)
+    {
+        header.emplace_backward(pool);
+        pool.deallocate(header.pop_forward());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_PayloadNodePool, 16);
+BENCHMARK_TEMPLATE(BM_PayloadNodePool, 64);
+BENCHMARK_TEMPLATE(BM_PayloadNodePool, 256);
+BENCHMARK_TEMPLATE(BM_PayloadNodePool, 1024);
+
+template <std::size_t Bytes>
+static void
+BM_PayloadDeque(benchmark::State &state)
+{
+    std::deque<Payload<Bytes>> queue;
+
+    for (auto _ : state)
+    {
+        queue.emplace_back();
+        benchmark::DoNotOptimize(queue.front());
+        queue.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_PayloadDeque, 16);
+BENCHMARK_TEMPLATE(BM_PayloadDeque, 64);
+BENCHMARK_TEMPLATE(BM_PayloadDeque, 256);
+BENCHMARK_TEMPLATE(BM_PayloadDeque, 1024);
+
+template <std::size_t Bytes>
+static void
+BM_PayloadList(benchmark::State &state)
+{
+    std::list<Payload<Bytes>> queue;
+
+    for (auto _ : state)
+    {
+        queue.emplace_back();
+        benchmark::DoNotOptimize(queue.front());
+        queue.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_PayloadList, 16);
+BENCHMARK_TEMPLATE(BM_PayloadList, 64);
+BENCHMARK_TEMPLATE(BM_PayloadList, 256);
+BENCHMARK_TEMPLATE(BM_PayloadList, 1024);
+
+template <std::size_t Bytes>
+static void
+BM_PayloadChunked(benchmark::State &state)
+{
+    ChunkedQueueHead<Payload<Bytes>> queue;
+    Payload<Bytes> data;
+
+    for (auto _ : state)
+    {
+        queue.emplace_backward();
+        queue.pop_forward(data);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * Bytes);
+}
+BENCHMARK_TEMPLATE(BM_PayloadChunked, 16);
+BENCHMARK_TEMPLATE(BM_PayloadChunked, 64);
+BENCHMARK_TEMPLATE(BM_PayloadChunked, 256);
+BENCHMARK_TEMPLATE(BM_PayloadChunked, 1024);
+
+//
+// Multi-threaded mixes: every thread alternately produces a node and consumes one, then produces the node it consumed,
+// so each node is only ever in the queue once.
+//
+static QueueHead<int> lockedHeader;
+static std::mutex lockedHeaderLock;
+
+static void
+BM_LockedQueueHeadMix(benchmark::State &state)
+{
+    Node<int> node(state.thread_index());
+    Node<int> *held = &node;
+
+    for (auto _ : state)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lockedHeaderLock);
+
+            lockedHeader.push_backward(held);
+        }
+        held = nullptr;
+        while (held == nullptr)
+        {
+            std::lock_guard<std::mutex> guard(lockedHeaderLock);
+
+            held = lockedHeader.pop_forward();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LockedQueueHeadMix)->ThreadRange(1, 8)->UseRealTime();
+
+static ConcurrentQueueHead<int> concurrentHeader;
+
+static void
+BM_ConcurrentQueueHeadMix(benchmark::State &state)
+{
+    Node<int> node(state.thread_index());
+    Node<int> *held = &node;
+
+    for (auto _ : state)
+    {
+        concurrentHeader.push_backward(held);
+        while ((held = concurrentHeader.pop_forward()) == nullptr)
+        {
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentQueueHeadMix)->ThreadRange(1, 8)->UseRealTime();
+
+static ShardedQueue<int> shardedHeader(8);
+
+static void
+BM_ShardedQueueMix(benchmark::State &state)
+{
+    Node<int> node(state.thread_index());
+    Node<int> *held = &node;
+    std::size_t shard = static_cast<std::size_t>(state.thread_index());
+
+    for (auto _ : state)
+    {
+        shardedHeader.push_backward(shard, held);
+        while ((held = shardedHeader.pop_backward(shard)) == nullptr)
+        {
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedQueueMix)->ThreadRange(1, 8)->UseRealTime();
+
+//
+// Push and pop through a PersistentQueueHead, with the number of operations per group commit (and so per fsync) as
+// the argument.
+//
+static std::string
+persistentPath(const char *name)
+{
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+
+    PersistentQueueHead<Payload<16>>::remove(path);
+    return path;
+}
+
+static void
+BM_PersistentPushPop(benchmark::State &state)
+{
+    std::string path = persistentPath("QueueBench.PushPop");
+    {
+        PersistentQueueHead<Payload<16>> header(path, 4096, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            header.emplace_backward();
+            header.deallocate(header.pop_forward());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    PersistentQueueHead<Payload<16>>::remove(path);
+}
+BENCHMARK(BM_PersistentPushPop)->RangeMultiplier(16)->Range(1, 4096);
+
+//
+// Recovery of a PersistentQueueHead, which replays one journal record per node.  By default it covers 64K to 1M nodes;
+// setting QUEUEBENCH_LARGE_RECOVERY in the environment adds 4M and 16M nodes, which write and sync about a gigabyte of
+// node and journal files, so they are left out of the regular runs.
+//
+static void
+BM_PersistentRecovery(benchmark::State &state)
+{
+    std::string path = persistentPath("QueueBench.Recovery");
+    std::uint64_t nodes = static_cast<std::uint64_t>(state.range(0));
+    {
+        PersistentQueueHead<Payload<16>> header(path, nodes, 65536);
+
+        while (header.emplace_backward())
+        {
+        }
+    }
+    for (auto _ : state)
+    {
+        PersistentQueueHead<Payload<16>> header(path, nodes);
+
+        benchmark::DoNotOptimize(header.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    PersistentQueueHead<Payload<16>>::remove(path);
+}
+BENCHMARK(BM_PersistentRecovery)
+    ->RangeMultiplier(4)
+    ->Range(1 << 16, (std::getenv("QUEUEBENCH_LARGE_RECOVERY") != nullptr) ? (1 << 24) : (1 << 20))
+    ->Unit(benchmark::kMillisecond);
+
+//
+// A retry timer, for the TimingWheel benchmarks.
+//
+struct RetryTimer
+{
+    std::uint64_t deadline = 0;
+};
+
+//
+// A TimingWheel holding the supplied number of timers, each rescheduled 1 to 4096 ticks ahead when it expires, with
+// the wheel advanced one tick at a time.  Reported per timer expired and rescheduled.
+//
+static void
+BM_TimingWheelTick(benchmark::State &state)
+{
+    std::size_t timers = static_cast<std::size_t>(state.range(0));
+    std::vector<Node<RetryTimer>> nodes(timers);
+    TimingWheel<RetryTimer> wheel;
+    QueueHead<RetryTimer> expired;
+    std::uint64_t random = 88172645463325252ull;
+    std::uint64_t now = 0;
+    std::int64_t fired = 0;
+
+    auto delay = [&random]()
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return 1 + (random & 4095);
+    };
+
+    for (Node<RetryTimer> &node : nodes)
+    {
+        wheel.schedule(&node, delay());
+    }
+    for (auto _ : state)
+    {
+        wheel.advance(++now, expired);
+        while (!expired.isEmpty())
+        {
+            wheel.schedule(expired.pop_forward(), now + delay());
+            fired++;
+        }
+    }
+    state.SetItemsProcessed(fired);
+    state.counters["timers_per_tick"] = benchmark::Counter(static_cast<double>(fired) / state.iterations());
+}
+BENCHMARK(BM_TimingWheelTick)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+
+//
+// Scheduling a timer and cancelling it before it expires, as for a request that is answered before its timeout.
+//
+static void
+BM_TimingWheelCancel(benchmark::State &state)
+{
+    TimingWheel<RetryTimer> wheel;
+    Node<RetryTimer> node;
+    std::uint64_t deadline = 0;
+
+    for (auto _ : state)
+    {
+        wheel.schedule(&node, ++deadline);
+        wheel.cancel(&node);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimingWheelCancel);
+
+BENCHMARK_MAIN();
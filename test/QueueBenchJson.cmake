@@ -0,0 +1,58 @@
+#
+# Copyright (C) Jonathan D. Belanger 2024.
+# All Rights Reserved.
+#
+# This software is furnished under a license and may be used and copied only
+# in accordance with the terms of such license and with the inclusion of the
+# above copyright notice.  This software or any other copies thereof may not
+# be provided or otherwise made available to any other person.  No title to
+# and ownership of the software is hereby transferred.
+#
+# The information in this software is subject to change without notice and
+# should not be construed as a commitment by the author or co-authors.
+#
+# The author and any co-authors assume no responsibility for the use or
+# reliability of this software.
+#
+# Description:
+#
+#   This script is run, with cmake -P, by the QueueBenchJson target.  It looks
+#   up the git commit when the target is built, rather than when cmake was
+#   configured, and runs QueueBench with the commit in the benchmark context.
+#
+#   Variables:
+#       BENCH           - The QueueBench executable.
+#       OUTPUT          - The JSON file to write.
+#       SOURCE_DIR      - The source tree, for git.
+#       GIT_EXECUTABLE  - git, if it was found.
+#
+# Revision History:
+#
+#   V01.000 16-Oct-2026 Jonathan D. Belanger
+#   Initially written.
+#
+#   V01.001 16-Oct-2026 Jonathan D. Belanger
+#   Keep "unknown" when git describe fails, such as in a tarball of the source.
+#
+set(GIT_SHA "unknown")
+if(GIT_EXECUTABLE)
+    execute_process(COMMAND
+        "${GIT_EXECUTABLE}" describe --match=NeVeRmAtCh --always --abbrev=40 --dirty
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        RESULT_VARIABLE gitResult
+        OUTPUT_VARIABLE gitOutput
+        ERROR_QUIET OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if((gitResult EQUAL 0) AND NOT (gitOutput STREQUAL ""))
+        set(GIT_SHA "${gitOutput}")
+    endif()
+endif()
+
+execute_process(COMMAND
+    "${BENCH}"
+    --benchmark_out=${OUTPUT}
+    --benchmark_out_format=json
+    --benchmark_context=git_sha=${GIT_SHA}
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "QueueBench failed: ${result}")
+endif()
@@ -22,8 +22,101 @@
 //  V01.000 16-Apr-2024 Jonathan D. Belanger
 //  Initially written.
 //
+//  V01.001 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the ConcurrentQueueHead.
+//
+//  V01.002 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the NodePool.
+//
+//  V01.003 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the splice, batch pop and chain push operations.
+//
+//  V01.004 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the node count, capacity and BlockingQueueHead.
+//
+//  V01.005 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the QueueHead iterators.
+//
+//  V01.006 16-Oct-2026 Jonathan D. Belanger
+//  Added tests, and a copy count/timing comparison, for the Node data references and in-place construction.
+//
+//  V01.007 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the BlockingQueueHead waiting consumers.
+//
+//  V01.008 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the PriorityQueueHead.
+//
+//  V01.009 16-Oct-2026 Jonathan D. Belanger
+//  Added tests, and a scaling comparison, for the ShardedQueue.
+//
+//  V01.010 16-Oct-2026 Jonathan D. Belanger
+//  Added tests, including one between two processes, for the SharedQueueHead.
+//
+//  V01.011 16-Oct-2026 Jonathan D. Belanger
+//  Added tests, including recovery after a crash, for the PersistentQueueHead.
+//
+//  V01.012 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the instrumentation policy.
+//
+//  V01.013 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for the ChunkedQueueHead.
+//
+//  V01.014 16-Oct-2026 Jonathan D. Belanger
+//  Added tests, including a comparison against a sorted list of deadlines, for the TimingWheel.
+//
+//  V01.015 16-Oct-2026 Jonathan D. Belanger
+//  Added tests for reusing PersistentQueueHead nodes when the pop is committed by its own group.
+//
+//  V01.016 16-Oct-2026 Jonathan D. Belanger
+//  Added a test of AgingPriority with three backed up lanes.
+//
+//  V01.017 16-Oct-2026 Jonathan D. Belanger
+//  Added a test that the NodePool rejects zero slab and batch sizes.
+//
+//  V01.018 16-Oct-2026 Jonathan D. Belanger
+//  Added a test of the order in which the TimingWheel returns nodes that were already due.
+//
+//  V01.019 16-Oct-2026 Jonathan D. Belanger
+//  Added a test that a SharedMemory object that cannot be mapped is unlinked.
+//
+//  V01.020 16-Oct-2026 Jonathan D. Belanger
+//  Added a test of a NodePool of over-aligned data.
+//
+//  V01.021 16-Oct-2026 Jonathan D. Belanger
+//  Added a test of a thread using many short-lived NodePools.
+//
+//  V01.022 16-Oct-2026 Jonathan D. Belanger
+//  Added a test of a ChunkedQueueHead of over-aligned data.
+//
 #include "Queue.hxx"
+#include "ConcurrentQueue.hxx"
+#include "NodePool.hxx"
+#include "BlockingQueue.hxx"
+#include "PriorityQueue.hxx"
+#include "ShardedQueue.hxx"
+#include "SharedQueue.hxx"
+#include "PersistentQueue.hxx"
+#include "QueueInstrumentation.hxx"
+#include "ChunkedQueue.hxx"
+#include "TimingWheel.hxx"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
 
 TEST(TestQueue, ClassInit)
 {
@@ -62,6 +155,121 @@ TEST(TestQueue, InsertBackward)
     EXPECT_EQ(314, node->getData());
 }
 
+//
+// Verify the queue contains the expected values, walking it both forward and backward.
+//
+static void
+expectQueue(QueueHead<int> &header, const std::vector<int> &expected)
+{
+    Node<int> *node = header.forward();
+    std::size_t ii = 0;
+
+    while (header != node)
+    {
+        ASSERT_LT(ii, expected.size());
+        EXPECT_EQ(expected[ii], node->getData());
+        ii++;
+        node = node->forward();
+    }
+    EXPECT_EQ(expected.size(), ii);
+    node = header.backward();
+    while (header != node)
+    {
+        ASSERT_GT(ii, 0);
+        ii--;
+        EXPECT_EQ(expected[ii], node->getData());
+        node = node->backward();
+    }
+    EXPECT_EQ(0, ii);
+}
+
+//
+// A payment record, roughly the size of the production one, that counts how many times it is copied and moved.
+//
+struct Payment
+{
+    Payment() = default;
+
+    Payment(long long amount, const char *payer, const char *payee) :
+        amountCents(amount),
+        payer(payer),
+        payee(payee),
+        reference("REF-0000000000000000000000000000000000000000000000"),
+        memo("Settlement of invoice 000000000000000000000000000000000")
+    {}
+
+    Payment(const Payment &other) :
+        amountCents(other.amountCents),
+        payer(other.payer),
+        payee(other.payee),
+        reference(other.reference),
+        memo(other.memo)
+    {
+        copies++;
+    }
+
+    Payment(Payment &&other) noexcept :
+        amountCents(other.amountCents),
+        payer(std::move(other.payer)),
+        payee(std::move(other.payee)),
+        reference(std::move(other.reference)),
+        memo(std::move(other.memo))
+    {
+        moves++;
+    }
+
+    Payment &operator=(const Payment &other)
+    {
+        Payment copy(other);
+
+        return *this = std::move(copy);
+    }
+
+    Payment &operator=(Payment &&other) noexcept
+    {
+        amountCents = other.amountCents;
+        payer = std::move(other.payer);
+        payee = std::move(other.payee);
+        reference = std::move(other.reference);
+        memo = std::move(other.memo);
+        moves++;
+        return *this;
+    }
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+
+    static inline long long copies = 0;
+    static inline long long moves = 0;
+
+    long long amountCents = 0;
+    std::string payer;
+    std::string payee;
+    std::string reference;
+    std::string memo;
+    char padding[160] = {};
+};
+
+//
+// A NodeAllocator that takes its nodes from the heap.
+//
+struct HeapAllocator
+{
+    template <class... Args>
+    Node<Payment> *emplace(Args &&...args)
+    {
+        return new Node<Payment>(std::in_place, std::forward<Args>(args)...);
+    }
+
+    void deallocate(Node<Payment> *node)
+    {
+        delete node;
+    }
+};
+
 TEST(TestQueue, InsertMultipleForward)
 {
     QueueHead<int> header;
@@ -217,6 +425,270 @@ TEST(TestQueue, PopTillEmpty)
     }
 }
 
+TEST(TestQueue, SpliceBackward)
+{
+    QueueHead<int> header;
+    QueueHead<int> other;
+
+    header.splice_backward(other);
+    EXPECT_TRUE(header.isEmpty());
+    for (int ii = 0; ii < 3; ii++)
+    {
+        other.push_backward(new Node<int>(ii));
+    }
+    header.splice_backward(other);
+    EXPECT_TRUE(other.isEmpty());
+    expectQueue(header, {0, 1, 2});
+    for (int ii = 3; ii < 6; ii++)
+    {
+        other.push_backward(new Node<int>(ii));
+    }
+    header.splice_backward(other);
+    EXPECT_TRUE(other.isEmpty());
+    expectQueue(header, {0, 1, 2, 3, 4, 5});
+    expectQueue(other, {});
+    header.splice_backward(header);
+    expectQueue(header, {0, 1, 2, 3, 4, 5});
+}
+
+TEST(TestQueue, SpliceForward)
+{
+    QueueHead<int> header;
+    QueueHead<int> other;
+
+    for (int ii = 3; ii < 6; ii++)
+    {
+        other.push_backward(new Node<int>(ii));
+    }
+    header.splice_forward(other);
+    EXPECT_TRUE(other.isEmpty());
+    expectQueue(header, {3, 4, 5});
+    for (int ii = 0; ii < 3; ii++)
+    {
+        other.push_backward(new Node<int>(ii));
+    }
+    header.splice_forward(other);
+    expectQueue(header, {0, 1, 2, 3, 4, 5});
+    expectQueue(other, {});
+    other.push_backward(header.pop_forward());
+    expectQueue(other, {0});
+    expectQueue(header, {1, 2, 3, 4, 5});
+}
+
+TEST(TestQueue, PopForwardN)
+{
+    QueueHead<int> header;
+    QueueHead<int> batch;
+
+    EXPECT_EQ(0, header.pop_forward_n(5, batch));
+    for (int ii = 0; ii < 10; ii++)
+    {
+        header.push_backward(new Node<int>(ii));
+    }
+    EXPECT_EQ(0, header.pop_forward_n(0, batch));
+    EXPECT_EQ(4, header.pop_forward_n(4, batch));
+    expectQueue(batch, {0, 1, 2, 3});
+    expectQueue(header, {4, 5, 6, 7, 8, 9});
+    EXPECT_EQ(6, header.pop_forward_n(100, batch));
+    EXPECT_TRUE(header.isEmpty());
+    expectQueue(batch, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    EXPECT_EQ(1, batch.pop_forward_n(1, header));
+    expectQueue(header, {0});
+}
+
+TEST(TestQueue, PushChain)
+{
+    QueueHead<int> header;
+    Node<int> *first = new Node<int>(2);
+    Node<int> *last = first;
+
+    for (int ii = 3; ii < 5; ii++)
+    {
+        last = last->insque(new Node<int>(ii));
+    }
+    header.push_backward(first, last);
+    expectQueue(header, {2, 3, 4});
+    first = new Node<int>(0);
+    last = first->insque(new Node<int>(1));
+    header.push_forward(first, last);
+    expectQueue(header, {0, 1, 2, 3, 4});
+    first = new Node<int>(5);
+    header.push_backward(first, first);
+    expectQueue(header, {0, 1, 2, 3, 4, 5});
+}
+
+TEST(TestQueue, Size)
+{
+    QueueHead<int> header;
+    QueueHead<int> other;
+    Node<int> *node = nullptr;
+
+    EXPECT_EQ(0, header.size());
+    for (int ii = 0; ii < 10; ii++)
+    {
+        header.push_backward(new Node<int>(ii));
+        header.push_forward(new Node<int>(ii));
+    }
+    EXPECT_EQ(20, header.size());
+    delete header.pop_forward();
+    delete header.pop_backward();
+    EXPECT_EQ(18, header.size());
+    EXPECT_EQ(5, header.pop_forward_n(5, other));
+    EXPECT_EQ(13, header.size());
+    EXPECT_EQ(5, other.size());
+    header.splice_forward(other);
+    EXPECT_EQ(18, header.size());
+    EXPECT_EQ(0, other.size());
+    EXPECT_EQ(18, header.pop_forward_n(100, other));
+    EXPECT_EQ(0, header.size());
+    EXPECT_EQ(18, other.size());
+    header.splice_backward(other);
+    EXPECT_EQ(18, header.size());
+    node = header.insque(header.forward(), new Node<int>(42));
+    EXPECT_EQ(19, header.size());
+    delete header.remque(node);
+    EXPECT_EQ(18, header.size());
+    node = new Node<int>(1);
+    node->insque(new Node<int>(2));
+    other.push_backward(node, node->forward());
+    EXPECT_EQ(2, other.size());
+    while (!header.isEmpty())
+    {
+        delete header.pop_forward();
+    }
+    EXPECT_EQ(0, header.size());
+}
+
+TEST(TestQueue, Capacity)
+{
+    QueueHead<int> unbounded;
+    QueueHead<int> header(3);
+
+    EXPECT_EQ(QueueHead<int>::unbounded, unbounded.capacity());
+    EXPECT_FALSE(unbounded.isFull());
+    EXPECT_EQ(3, header.capacity());
+    EXPECT_TRUE(header.try_push_backward(new Node<int>(1)));
+    EXPECT_TRUE(header.try_push_forward(new Node<int>(0)));
+    EXPECT_TRUE(header.try_push_backward(new Node<int>(2)));
+    EXPECT_TRUE(header.isFull());
+
+    Node<int> *node = new Node<int>(3);
+
+    EXPECT_FALSE(header.try_push_backward(node));
+    EXPECT_FALSE(header.try_push_forward(node));
+    EXPECT_TRUE(node->isUnlinked());
+    expectQueue(header, {0, 1, 2});
+    delete header.pop_forward();
+    EXPECT_FALSE(header.isFull());
+    EXPECT_TRUE(header.try_push_backward(node));
+    expectQueue(header, {1, 2, 3});
+}
+
+static_assert(std::bidirectional_iterator<QueueHead<int>::iterator>);
+static_assert(std::bidirectional_iterator<QueueHead<int>::const_iterator>);
+static_assert(std::ranges::bidirectional_range<QueueHead<int>>);
+static_assert(std::ranges::bidirectional_range<const QueueHead<int>>);
+
+TEST(TestQueue, Iterate)
+{
+    QueueHead<int> header;
+    const QueueHead<int> &constHeader = header;
+    int ii = 0;
+
+    EXPECT_TRUE(header.begin() == header.end());
+    EXPECT_TRUE(header.rbegin() == header.rend());
+    for (ii = 0; ii < 10; ii++)
+    {
+        header.push_backward(new Node<int>(ii));
+    }
+    ii = 0;
+    for (int &data : header)
+    {
+        EXPECT_EQ(ii, data);
+        data *= 10;
+        ii++;
+    }
+    EXPECT_EQ(10, ii);
+    EXPECT_EQ(90, header.backward()->getData());
+    ii = 9;
+    for (auto it = constHeader.rbegin(); it != constHeader.rend(); it++)
+    {
+        EXPECT_EQ(ii * 10, *it);
+        ii--;
+    }
+    EXPECT_EQ(-1, ii);
+    EXPECT_EQ(10, std::distance(header.cbegin(), header.cend()));
+
+    auto found = std::ranges::find_if(header, [](int data) { return data == 50; });
+
+    ASSERT_TRUE(found != header.end());
+    EXPECT_EQ(50, found.node()->getData());
+    EXPECT_EQ(40, *std::prev(found));
+    EXPECT_TRUE(std::ranges::equal(header | std::views::reverse | std::views::take(2), std::vector<int>{90, 80}));
+}
+
+TEST(TestQueue, EraseInsert)
+{
+    QueueHead<int> header;
+
+    for (int ii = 0; ii < 5; ii++)
+    {
+        header.push_backward(new Node<int>(ii));
+    }
+
+    auto it = std::ranges::find(header, 2);
+    Node<int> *node = it.node();
+
+    it = header.erase(it);
+    EXPECT_TRUE(node->isUnlinked());
+    EXPECT_EQ(3, *it);
+    EXPECT_EQ(4, header.size());
+    expectQueue(header, {0, 1, 3, 4});
+    it = header.insert(it, node);
+    EXPECT_EQ(2, *it);
+    EXPECT_EQ(5, header.size());
+    expectQueue(header, {0, 1, 2, 3, 4});
+    header.insert(header.end(), new Node<int>(5));
+    header.insert(header.begin(), new Node<int>(-1));
+    expectQueue(header, {-1, 0, 1, 2, 3, 4, 5});
+    it = header.begin();
+    while (it != header.end())
+    {
+        node = it.node();
+        it = header.erase(it);
+        delete node;
+    }
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(0, header.size());
+}
+
+TEST(TestQueue, Emplace)
+{
+    NodePool<Payment> pool;
+    HeapAllocator heap;
+    QueueHead<Payment> header;
+    Payment data;
+
+    Payment::reset();
+    Payment &first = header.emplace_backward(pool, 100, "alice", "bob");
+    Payment &second = header.emplace_backward(heap, 200, "carol", "dave");
+    Payment &zeroth = header.emplace_forward(pool, 50, "erin", "frank");
+
+    EXPECT_EQ(0, Payment::copies);
+    EXPECT_EQ(0, Payment::moves);
+    EXPECT_EQ(&first, &header.forward()->forward()->data());
+    EXPECT_EQ(&second, &header.backward()->data());
+    EXPECT_EQ(&zeroth, &*header.begin());
+    EXPECT_EQ(3, header.size());
+    EXPECT_TRUE(header.pop_forward(pool, data));
+    EXPECT_EQ(50, data.amountCents);
+    EXPECT_EQ("erin", data.payer);
+    EXPECT_TRUE(header.pop_forward(pool, data));
+    EXPECT_EQ("bob", data.payee);
+    heap.deallocate(header.pop_forward());
+    EXPECT_EQ(0, Payment::copies);
+}
+
 TEST(TestNode, ClassInit)
 {
     Node<int> node;
@@ -378,6 +850,1666 @@ TEST(TestNode, Remque)
     }
 }
 
+TEST(TestConcurrentQueue, ClassInit)
+{
+    ConcurrentQueueHead<int> header;
+
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(nullptr, header.pop_forward());
+}
+
+TEST(TestConcurrentQueue, PushPop)
+{
+    ConcurrentQueueHead<int> header;
+    Node<int> *node = nullptr;
+
+    for (int ii = 0; ii < 10; ii++)
+    {
+        node = new Node<int>(ii);
+        header.push_backward(node);
+        EXPECT_FALSE(node->isUnlinked());
+    }
+    EXPECT_FALSE(header.isEmpty());
+    for (int ii = 0; ii < 10; ii++)
+    {
+        node = header.pop_forward();
+        ASSERT_TRUE(node != nullptr);
+        EXPECT_EQ(ii, node->getData());
+        EXPECT_TRUE(node->isUnlinked());
+        delete node;
+    }
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(nullptr, header.pop_forward());
+}
+
+TEST(TestConcurrentQueue, PushChain)
+{
+    ConcurrentQueueHead<int> header;
+    Node<int> *first = new Node<int>(0);
+    Node<int> *last = first;
+    Node<int> *node = nullptr;
+
+    for (int ii = 1; ii < 5; ii++)
+    {
+        last = last->insque(new Node<int>(ii));
+    }
+    header.push_backward(first, last);
+    header.push_backward(new Node<int>(5));
+    for (int ii = 0; ii < 6; ii++)
+    {
+        node = header.pop_forward();
+        ASSERT_TRUE(node != nullptr);
+        EXPECT_EQ(ii, node->getData());
+        delete node;
+    }
+    EXPECT_TRUE(header.isEmpty());
+}
+
+TEST(TestConcurrentQueue, StressProducersConsumers)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr std::uint64_t perProducer = 20000;
+    ConcurrentQueueHead<std::uint64_t> header;
+    std::vector<Node<std::uint64_t>*> nodes;
+    std::vector<std::atomic<int>> seen(producers * perProducer);
+    std::atomic<std::uint64_t> consumed = 0;
+    std::atomic<bool> outOfOrder = false;
+    std::vector<std::thread> threads;
+
+    for (std::uint64_t ii = 0; ii < producers * perProducer; ii++)
+    {
+        nodes.push_back(new Node<std::uint64_t>(ii));
+    }
+    for (int ii = 0; ii < producers; ii++)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            for (std::uint64_t jj = 0; jj < perProducer; jj++)
+            {
+                header.push_backward(nodes[(ii * perProducer) + jj]);
+            }
+        });
+    }
+    for (int ii = 0; ii < consumers; ii++)
+    {
+        threads.emplace_back([&]()
+        {
+            std::vector<std::uint64_t> last(producers, 0);
+            std::vector<bool> any(producers, false);
+
+            while (consumed.load() < (producers * perProducer))
+            {
+                Node<std::uint64_t> *node = header.pop_forward();
+
+                if (node == nullptr)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::uint64_t data = node->getData();
+                std::uint64_t producer = data / perProducer;
+
+                if (any[producer] && (last[producer] >= data))
+                {
+                    outOfOrder = true;
+                }
+                any[producer] = true;
+                last[producer] = data;
+                seen[data]++;
+                consumed++;
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_FALSE(outOfOrder.load());
+    EXPECT_TRUE(header.isEmpty());
+    for (std::uint64_t ii = 0; ii < producers * perProducer; ii++)
+    {
+        EXPECT_EQ(1, seen[ii].load());
+        EXPECT_TRUE(nodes[ii]->isUnlinked());
+        delete nodes[ii];
+    }
+}
+
+TEST(TestConcurrentQueue, StressRecycle)
+{
+    constexpr int threadCount = 8;
+    constexpr int nodeCount = 16;
+    constexpr int iterations = 20000;
+    ConcurrentQueueHead<int> header;
+    std::vector<Node<int>*> nodes;
+    std::vector<std::thread> threads;
+
+    for (int ii = 0; ii < nodeCount; ii++)
+    {
+        nodes.push_back(new Node<int>(ii));
+        header.push_backward(nodes.back());
+    }
+    for (int ii = 0; ii < threadCount; ii++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int jj = 0; jj < iterations; jj++)
+            {
+                Node<int> *node = header.pop_forward();
+
+                if (node != nullptr)
+                {
+                    EXPECT_TRUE(node->isUnlinked());
+                    header.push_backward(node);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int> seen(nodeCount, 0);
+    Node<int> *node = nullptr;
+
+    while ((node = header.pop_forward()) != nullptr)
+    {
+        seen[node->getData()]++;
+    }
+    for (int ii = 0; ii < nodeCount; ii++)
+    {
+        EXPECT_EQ(1, seen[ii]);
+        delete nodes[ii];
+    }
+}
+
+TEST(TestNodePool, Reuse)
+{
+    NodePool<int> pool;
+    Node<int> *node = pool.allocate(42);
+    Node<int> *again = nullptr;
+
+    EXPECT_TRUE(node->isUnlinked());
+    EXPECT_EQ(42, node->getData());
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(node) % NodePool<int>::cacheLine);
+    pool.deallocate(node);
+    again = pool.allocate(7);
+    EXPECT_EQ(node, again);
+    EXPECT_EQ(7, again->getData());
+    pool.deallocate(again);
+    EXPECT_EQ(1, pool.slabCount());
+}
+
+TEST(TestNodePool, ZeroSizes)
+{
+    EXPECT_THROW(NodePool<int>(0, 64), std::invalid_argument);
+    EXPECT_THROW(NodePool<int>(1024, 0), std::invalid_argument);
+    EXPECT_THROW(NodePool<int>(0, 0), std::invalid_argument);
+
+    NodePool<int> pool(1, 1);
+    Node<int> *first = pool.allocate(1);
+    Node<int> *second = pool.allocate(2);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(2, pool.slabCount());
+    pool.deallocate(first);
+    pool.deallocate(second);
+}
+
+TEST(TestNodePool, OverAligned)
+{
+    struct alignas(1024) Wide
+    {
+        int value;
+    };
+    NodePool<Wide> pool(4, 2);
+    std::vector<Node<Wide>*> nodes;
+
+    for (int ii = 0; ii < 10; ii++)
+    {
+        nodes.push_back(pool.emplace(ii));
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(nodes.back()) % alignof(Node<Wide>));
+    }
+    for (Node<Wide> *node : nodes)
+    {
+        pool.deallocate(node);
+    }
+}
+
+TEST(TestNodePool, ManyShortLivedPools)
+{
+    NodePool<int> lasting;
+    Node<int> *kept = lasting.allocate(1);
+
+    //
+    // Each new pool drops the calling thread's entries for the pools already destroyed, but not for one still in use.
+    //
+    for (int ii = 0; ii < 1000; ii++)
+    {
+        NodePool<int> pool(8, 4);
+
+        pool.deallocate(pool.allocate(ii));
+    }
+    lasting.deallocate(kept);
+    EXPECT_EQ(kept, lasting.allocate(2));
+    EXPECT_EQ(1, lasting.slabCount());
+}
+
+TEST(TestNodePool, QueueSteadyState)
+{
+    NodePool<int> pool(256, 32);
+    QueueHead<int> header;
+    int data = 0;
+
+    for (int ii = 0; ii < 200; ii++)
+    {
+        header.push_backward(pool, ii);
+    }
+    for (int ii = 0; ii < 100000; ii++)
+    {
+        EXPECT_TRUE(header.pop_forward(pool, data));
+        EXPECT_EQ(ii, data);
+        header.push_backward(pool, ii + 200);
+    }
+    EXPECT_EQ(1, pool.slabCount());
+    header.push_forward(pool, -1);
+    EXPECT_TRUE(header.pop_forward(pool, data));
+    EXPECT_EQ(-1, data);
+    EXPECT_TRUE(header.pop_backward(pool, data));
+    EXPECT_EQ(100199, data);
+    while (header.pop_forward(pool, data))
+    {
+    }
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_FALSE(header.pop_backward(pool, data));
+}
+
+TEST(TestNodePool, CrossThread)
+{
+    constexpr int items = 100000;
+    NodePool<int> pool(128, 16);
+    ConcurrentQueueHead<int> header;
+    std::atomic<int> inFlight = 0;
+    long long sum = 0;
+
+    std::thread producer([&]()
+    {
+        for (int ii = 0; ii < items; ii++)
+        {
+            while (inFlight.load() >= 1000)
+            {
+                std::this_thread::yield();
+            }
+            inFlight++;
+            header.push_backward(pool.allocate(ii));
+        }
+    });
+    std::thread consumer([&]()
+    {
+        for (int ii = 0; ii < items;)
+        {
+            Node<int> *node = header.pop_forward();
+
+            if (node == nullptr)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            sum += node->getData();
+            pool.deallocate(node);
+            inFlight--;
+            ii++;
+        }
+    });
+    producer.join();
+    consumer.join();
+    EXPECT_EQ((static_cast<long long>(items) * (items - 1)) / 2, sum);
+    EXPECT_LE(pool.slabCount(), 10);
+}
+
+TEST(TestNode, DataReference)
+{
+    Node<Payment> node(std::in_place, 42, "alice", "bob");
+    const Node<Payment> &constNode = node;
+
+    Payment::reset();
+    EXPECT_EQ(42, node.data().amountCents);
+    node.data().amountCents = 43;
+    EXPECT_EQ(43, constNode.data().amountCents);
+    EXPECT_EQ("alice", constNode.data().payer);
+    EXPECT_EQ(0, Payment::copies);
+    EXPECT_EQ(43, node.getData().amountCents);
+    EXPECT_EQ(1, Payment::copies);
+}
+
+TEST(TestNode, MoveConstruct)
+{
+    Payment payment(42, "alice", "bob");
+
+    Payment::reset();
+    Node<Payment> copied(payment);
+    EXPECT_EQ(1, Payment::copies);
+    Node<Payment> moved(std::move(payment));
+    EXPECT_EQ(1, Payment::copies);
+    EXPECT_EQ(1, Payment::moves);
+    EXPECT_EQ("alice", moved.data().payer);
+    Node<Payment> emplaced(std::in_place, 7, "carol", "dave");
+    EXPECT_EQ(1, Payment::copies);
+    EXPECT_EQ(1, Payment::moves);
+    EXPECT_EQ(7, emplaced.data().amountCents);
+}
+
+//
+// Compare enqueueing, peeking at and dequeueing payments by value (copying them into the node and out again) with
+// constructing them in a pooled node and accessing them by reference.
+//
+TEST(TestNode, CopyBenchmark)
+{
+    constexpr int items = 100000;
+    QueueHead<Payment> header;
+    NodePool<Payment> pool;
+    long long sum = 0;
+
+    Payment::reset();
+    auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < items; ii++)
+    {
+        Payment payment(ii, "alice", "bob");
+
+        header.push_backward(new Node<Payment>(payment));
+        Payment peek = header.backward()->getData();
+        sum += peek.amountCents;
+        Node<Payment> *node = header.pop_forward();
+        Payment settled = node->getData();
+        sum += settled.amountCents;
+        delete node;
+    }
+    auto byValue = std::chrono::steady_clock::now() - start;
+    long long byValueCopies = Payment::copies;
+
+    Payment::reset();
+    start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < items; ii++)
+    {
+        sum -= header.emplace_backward(pool, ii, "alice", "bob").amountCents;
+        Node<Payment> *node = header.pop_forward();
+        sum -= node->data().amountCents;
+        pool.deallocate(node);
+    }
+    auto inPlace = std::chrono::steady_clock::now() - start;
+    long long inPlaceCopies = Payment::copies;
+
+    EXPECT_EQ(0, sum);
+    EXPECT_EQ(3LL * items, byValueCopies);
+    EXPECT_EQ(0, inPlaceCopies);
+    std::cout << "[ BENCH    ] " << items << " payments by value: " << byValueCopies << " copies, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(byValue).count() << " us" << std::endl;
+    std::cout << "[ BENCH    ] " << items << " payments in place: " << inPlaceCopies << " copies, "
+              << std::chrono::duration_cast<std::chrono::microseconds>(inPlace).count() << " us" << std::endl;
+}
+
+TEST(TestNode, InsqueRemqueAtEnds)
+{
+    QueueHead<int> header;
+    Node<int> *node = new Node<int>(1);
+
+    header.push_backward(node);
+    node->insque(new Node<int>(2));
+    header.forward()->backward()->insque(new Node<int>(0));
+    expectQueue(header, {0, 1, 2});
+    header.backward()->insque(new Node<int>(3));
+    expectQueue(header, {0, 1, 2, 3});
+    delete header.backward()->remque();
+    delete header.backward()->remque();
+    expectQueue(header, {0, 1});
+    delete header.forward()->remque();
+    expectQueue(header, {1});
+    delete node->remque();
+    EXPECT_TRUE(header.isEmpty());
+}
+
+TEST(TestBlockingQueue, TryPush)
+{
+    BlockingQueueHead<int> header(2);
+    Node<int> *node = new Node<int>(3);
+
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(2, header.capacity());
+    EXPECT_TRUE(header.try_push_backward(new Node<int>(1)));
+    EXPECT_TRUE(header.try_push_backward(new Node<int>(2)));
+    EXPECT_FALSE(header.try_push_backward(node));
+    EXPECT_FALSE(header.push_backward_wait_for(node, std::chrono::milliseconds(10)));
+    EXPECT_EQ(2, header.size());
+    delete header.pop_forward();
+    EXPECT_TRUE(header.push_backward_wait_for(node, std::chrono::milliseconds(10)));
+    delete header.pop_forward();
+    node = header.pop_forward();
+    ASSERT_TRUE(node != nullptr);
+    EXPECT_EQ(3, node->getData());
+    delete node;
+    EXPECT_EQ(nullptr, header.pop_forward());
+}
+
+TEST(TestBlockingQueue, Backpressure)
+{
+    constexpr int items = 10000;
+    constexpr int capacity = 4;
+    BlockingQueueHead<int> header(capacity);
+    std::atomic<bool> overCapacity = false;
+
+    std::thread producer([&]()
+    {
+        for (int ii = 0; ii < items; ii++)
+        {
+            header.push_backward_wait(new Node<int>(ii));
+            if (header.size() > capacity)
+            {
+                overCapacity = true;
+            }
+        }
+    });
+    for (int ii = 0; ii < items;)
+    {
+        Node<int> *node = header.pop_forward();
+
+        if (node == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_EQ(ii, node->getData());
+        delete node;
+        ii++;
+    }
+    producer.join();
+    EXPECT_FALSE(overCapacity.load());
+    EXPECT_TRUE(header.isEmpty());
+}
+
+TEST(TestBlockingQueue, PopWait)
+{
+    constexpr int items = 10000;
+    BlockingQueueHead<int> header;
+    std::vector<std::thread> consumers;
+    std::atomic<long long> sum = 0;
+
+    EXPECT_EQ(nullptr, header.pop_forward_wait_for(std::chrono::milliseconds(10)));
+    for (int ii = 0; ii < 4; ii++)
+    {
+        consumers.emplace_back([&]()
+        {
+            while (true)
+            {
+                Node<int> *node = header.pop_forward_wait();
+
+                if (node->data() < 0)
+                {
+                    delete node;
+                    break;
+                }
+                sum += node->data();
+                delete node;
+            }
+        });
+    }
+    for (int ii = 0; ii < items; ii++)
+    {
+        header.push_backward_wait(new Node<int>(ii));
+    }
+    for (int ii = 0; ii < 4; ii++)
+    {
+        header.push_backward_wait(new Node<int>(-1));
+    }
+    for (auto &consumer : consumers)
+    {
+        consumer.join();
+    }
+    EXPECT_EQ((static_cast<long long>(items) * (items - 1)) / 2, sum.load());
+    EXPECT_TRUE(header.isEmpty());
+
+    std::thread producer([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        header.push_backward_wait(new Node<int>(42));
+    });
+    Node<int> *node = header.pop_forward_wait_for(std::chrono::seconds(10));
+
+    producer.join();
+    ASSERT_TRUE(node != nullptr);
+    EXPECT_EQ(42, node->data());
+    delete node;
+}
+
+//
+// A coroutine that starts immediately and cleans up after itself when it completes.
+//
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static Detached
+consume(BlockingQueueHead<int> &header, std::vector<int> &received, int count)
+{
+    for (int ii = 0; ii < count; ii++)
+    {
+        Node<int> *node = co_await header.pop_forward_async();
+
+        received.push_back(node->data());
+        delete node;
+    }
+}
+
+TEST(TestBlockingQueue, PopAsync)
+{
+    BlockingQueueHead<int> header;
+    std::vector<int> received;
+
+    header.push_backward_wait(new Node<int>(0));
+    consume(header, received, 4);
+    EXPECT_EQ(std::vector<int>({0}), received);
+    header.push_backward_wait(new Node<int>(1));
+    EXPECT_EQ(std::vector<int>({0, 1}), received);
+    EXPECT_TRUE(header.try_push_backward(new Node<int>(2)));
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), received);
+    EXPECT_TRUE(header.isEmpty());
+
+    std::thread producer([&]()
+    {
+        header.push_backward_wait(new Node<int>(3));
+        header.push_backward_wait(new Node<int>(4));
+    });
+    producer.join();
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), received);
+    EXPECT_EQ(1, header.size());
+    delete header.pop_forward();
+}
+
+TEST(TestPriorityQueue, StrictOrder)
+{
+    enum Lane { bulk, standard, urgent };
+    PriorityQueueHead<int, 3> header;
+    Node<int> *node = nullptr;
+
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(nullptr, header.pop_forward());
+    for (int ii = 0; ii < 3; ii++)
+    {
+        header.push_backward(new Node<int>(ii), bulk);
+        header.push_backward(new Node<int>(10 + ii), standard);
+        header.push_backward(new Node<int>(20 + ii), urgent);
+    }
+    header.push_forward(new Node<int>(19), urgent);
+    EXPECT_EQ(10, header.size());
+    EXPECT_EQ(3, header.lane(bulk).size());
+    for (int expected : {19, 20, 21, 22, 10, 11, 12, 0, 1, 2})
+    {
+        node = header.pop_forward();
+        ASSERT_TRUE(node != nullptr);
+        EXPECT_EQ(expected, node->data());
+        delete node;
+        if (expected == 21)
+        {
+            header.push_backward(new Node<int>(22), urgent);
+            delete header.pop_forward(urgent);
+        }
+    }
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(0, header.size());
+    EXPECT_EQ(nullptr, header.pop_forward(bulk));
+}
+
+TEST(TestPriorityQueue, WideLanes)
+{
+    PriorityQueueHead<int, 64> header;
+
+    header.push_backward(new Node<int>(0), 0);
+    header.push_backward(new Node<int>(63), 63);
+    header.push_backward(new Node<int>(31), 31);
+    for (int expected : {63, 31, 0})
+    {
+        Node<int> *node = header.pop_forward();
+
+        ASSERT_TRUE(node != nullptr);
+        EXPECT_EQ(expected, node->data());
+        delete node;
+    }
+    EXPECT_TRUE(header.isEmpty());
+}
+
+TEST(TestPriorityQueue, Aging)
+{
+    PriorityQueueHead<int, 3, AgingPriority<3>> header;
+    std::vector<int> order;
+
+    for (int ii = 0; ii < 8; ii++)
+    {
+        header.push_backward(new Node<int>(20 + ii), 2);
+    }
+    header.push_backward(new Node<int>(0), 0);
+    header.push_backward(new Node<int>(1), 0);
+    while (!header.isEmpty())
+    {
+        Node<int> *node = header.pop_forward();
+
+        order.push_back(node->data());
+        delete node;
+    }
+    EXPECT_EQ(std::vector<int>({20, 21, 22, 0, 23, 24, 25, 1, 26, 27}), order);
+}
+
+TEST(TestPriorityQueue, AgingEveryLane)
+{
+    PriorityQueueHead<int, 3, AgingPriority<2>> header;
+    std::vector<int> order;
+    std::array<std::size_t, 3> passedOver{};
+
+    //
+    // Urgent (2), standard (1) and bulk (0) are all backed up.  Each lane, including the standard lane in the middle,
+    // is serviced at least once in every Budget + Levels selections.
+    //
+    for (int ii = 0; ii < 20; ii++)
+    {
+        for (std::size_t level = 0; level < 3; level++)
+        {
+            header.push_backward(new Node<int>(static_cast<int>(level)), level);
+        }
+    }
+    while (!header.isEmpty())
+    {
+        Node<int> *node = header.pop_forward();
+
+        order.push_back(node->data());
+        for (std::size_t level = 0; level < 3; level++)
+        {
+            if (!header.lane(level).isEmpty() || (static_cast<int>(level) == node->data()))
+            {
+                passedOver[level] = (static_cast<int>(level) == node->data()) ? 0 : passedOver[level] + 1;
+                EXPECT_LT(passedOver[level], 2 + 3);
+            }
+        }
+        delete node;
+    }
+    EXPECT_EQ(std::vector<int>({2, 2, 1, 0, 2, 1, 0, 2, 1}), std::vector<int>(order.begin(), order.begin() + 9));
+    EXPECT_GE(std::count(order.begin(), order.begin() + 15, 1), 3);
+}
+
+TEST(TestShardedQueue, OwnerAndSteal)
+{
+    ShardedQueue<int> header(3);
+    Node<int> *node = nullptr;
+
+    EXPECT_EQ(3, header.shardCount());
+    EXPECT_EQ(nullptr, header.pop_backward(0));
+    for (int ii = 0; ii < 6; ii++)
+    {
+        header.push_backward(1, new Node<int>(ii));
+    }
+    EXPECT_EQ(6, header.size());
+    node = header.pop_backward(1);
+    EXPECT_EQ(5, node->data());
+    delete node;
+
+    //
+    // Shard 0 is empty, so it steals the first half of shard 1 (0, 1, 2) and keeps 1 and 2.
+    //
+    node = header.pop_backward(0);
+    EXPECT_EQ(0, node->data());
+    delete node;
+    EXPECT_EQ(4, header.size());
+    for (int expected : {2, 1})
+    {
+        node = header.pop_backward(0);
+        EXPECT_EQ(expected, node->data());
+        delete node;
+    }
+    for (int expected : {4, 3})
+    {
+        node = header.pop_backward(1);
+        EXPECT_EQ(expected, node->data());
+        delete node;
+    }
+    EXPECT_EQ(0, header.size());
+    EXPECT_EQ(nullptr, header.steal(2));
+}
+
+//
+// Run a set of workers over a ShardedQueue, with worker 0 starting with most of the work, and return the number of
+// nodes processed per second.
+//
+static double
+runShardedWorkers(std::size_t workers, int perWorker, std::vector<int> &seen)
+{
+    ShardedQueue<int> header(workers);
+    std::vector<Node<int>*> nodes;
+    std::vector<std::thread> threads;
+    std::atomic<int> remaining = static_cast<int>(workers) * perWorker;
+
+    for (int ii = 0; ii < remaining.load(); ii++)
+    {
+        nodes.push_back(new Node<int>(ii));
+    }
+    for (int ii = 0; ii < remaining.load(); ii++)
+    {
+        header.push_backward(((ii % 4) == 0) ? (ii % workers) : 0, nodes[ii]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t ii = 0; ii < workers; ii++)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            while (remaining.load(std::memory_order_relaxed) > 0)
+            {
+                Node<int> *node = header.pop_backward(ii);
+
+                if (node == nullptr)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen[node->data()]++;
+                remaining--;
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (Node<int> *node : nodes)
+    {
+        delete node;
+    }
+    return (static_cast<double>(workers) * perWorker) / seconds;
+}
+
+TEST(TestShardedQueue, ScalingBenchmark)
+{
+    constexpr int perWorker = 50000;
+    std::size_t maxWorkers = std::thread::hardware_concurrency();
+
+    if (maxWorkers < 4)
+    {
+        maxWorkers = 4;
+    }
+    for (std::size_t workers = 1; workers <= maxWorkers; workers *= 2)
+    {
+        std::vector<int> seen(workers * perWorker, 0);
+        double rate = runShardedWorkers(workers, perWorker, seen);
+
+        EXPECT_EQ(seen.size(), static_cast<std::size_t>(std::count(seen.begin(), seen.end(), 1)));
+        std::cout << "[ BENCH    ] " << workers << " workers: " << static_cast<long long>(rate) << " nodes/s"
+                  << std::endl;
+    }
+}
+
+//
+// A payment that can be placed in a shared region: trivially copyable and without pointers.
+//
+struct Transfer
+{
+    std::uint64_t id;
+    std::int64_t cents;
+};
+
+TEST(TestSharedQueue, ClassInit)
+{
+    std::vector<std::uint64_t> region(SharedQueueHead<Transfer>::regionSize(4) / sizeof(std::uint64_t) + 1, 0);
+    SharedQueueHead<Transfer> *header = nullptr;
+
+    EXPECT_EQ(nullptr, SharedQueueHead<Transfer>::attach(region.data()));
+    EXPECT_EQ(nullptr, SharedQueueHead<Transfer>::create(region.data(), SharedQueueHead<Transfer>::regionSize(0)));
+    header = SharedQueueHead<Transfer>::create(region.data(), region.size() * sizeof(std::uint64_t));
+    ASSERT_NE(nullptr, header);
+    EXPECT_EQ(header, SharedQueueHead<Transfer>::attach(region.data()));
+    EXPECT_EQ(nullptr, SharedQueueHead<int>::attach(region.data()));
+    EXPECT_TRUE(header->isEmpty());
+    EXPECT_EQ(4, header->capacity());
+    EXPECT_EQ(nullptr, header->pop_forward());
+    EXPECT_EQ(nullptr, header->pop_backward());
+}
+
+TEST(TestSharedQueue, PushPop)
+{
+    std::vector<std::uint64_t> region(SharedQueueHead<Transfer>::regionSize(3) / sizeof(std::uint64_t), 0);
+    SharedQueueHead<Transfer> *header =
+        SharedQueueHead<Transfer>::create(region.data(), region.size() * sizeof(std::uint64_t));
+    SharedNode<Transfer> *node = nullptr;
+
+    ASSERT_NE(nullptr, header);
+    EXPECT_TRUE(header->emplace_backward(Transfer{2, 200}));
+    node = header->allocate();
+    node->data() = Transfer{1, 100};
+    header->push_forward(node);
+    node = header->allocate();
+    node->data() = Transfer{3, 300};
+    header->push_backward(node);
+    EXPECT_EQ(nullptr, header->allocate());
+    EXPECT_FALSE(header->emplace_backward(Transfer{4, 400}));
+    EXPECT_EQ(3, header->size());
+
+    node = header->pop_backward();
+    EXPECT_EQ(3, node->data().id);
+    header->deallocate(node);
+    for (std::uint64_t expected : {1, 2})
+    {
+        node = header->pop_forward();
+        EXPECT_EQ(expected, node->data().id);
+        EXPECT_EQ(static_cast<std::int64_t>(expected * 100), node->data().cents);
+        header->deallocate(node);
+    }
+    EXPECT_TRUE(header->isEmpty());
+    EXPECT_TRUE(header->emplace_backward(Transfer{5, 500}));
+}
+
+TEST(TestSharedQueue, TwoMappings)
+{
+    std::string name = "/StaxSharedQueue." + std::to_string(::getpid());
+    SharedMemory first(name, SharedQueueHead<Transfer>::regionSize(16));
+    SharedMemory second(name);
+    SharedQueueHead<Transfer> *writer = SharedQueueHead<Transfer>::create(first.address(), first.size());
+    SharedQueueHead<Transfer> *reader = SharedQueueHead<Transfer>::attach(second.address());
+    SharedNode<Transfer> *written = nullptr;
+    SharedNode<Transfer> *node = nullptr;
+
+    SharedMemory::unlink(name);
+    ASSERT_NE(nullptr, writer);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_NE(first.address(), second.address());
+    EXPECT_EQ(16, reader->capacity());
+
+    //
+    // The node is written through one mapping and read, in place, through the other.
+    //
+    written = writer->allocate();
+    written->data() = Transfer{7, 700};
+    writer->push_backward(written);
+    EXPECT_EQ(1, reader->size());
+    node = reader->pop_forward();
+    ASSERT_NE(nullptr, node);
+    EXPECT_NE(written, node);
+    EXPECT_EQ(reinterpret_cast<char *>(written) - static_cast<char *>(first.address()),
+              reinterpret_cast<char *>(node) - static_cast<char *>(second.address()));
+    EXPECT_EQ(7, node->data().id);
+    EXPECT_EQ(700, node->data().cents);
+    EXPECT_TRUE(writer->isEmpty());
+}
+
+TEST(TestSharedQueue, TwoProcesses)
+{
+    constexpr std::uint64_t transfers = 10000;
+    std::string name = "/StaxSharedQueue." + std::to_string(::getpid());
+    SharedMemory region(name, SharedQueueHead<Transfer>::regionSize(64));
+    SharedQueueHead<Transfer> *header = SharedQueueHead<Transfer>::create(region.address(), region.size());
+    std::uint64_t expected = 0;
+    int status = 0;
+
+    ASSERT_NE(nullptr, header);
+
+    //
+    // The child maps the region again, so at a different address, and produces more transfers than there are nodes,
+    // so it has to wait for the parent to hand them back.
+    //
+    pid_t child = ::fork();
+
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        SharedMemory mine(name);
+        SharedQueueHead<Transfer> *producer = SharedQueueHead<Transfer>::attach(mine.address());
+
+        if (producer == nullptr)
+        {
+            ::_exit(1);
+        }
+        for (std::uint64_t ii = 0; ii < transfers; ii++)
+        {
+            while (!producer->emplace_backward(Transfer{ii, static_cast<std::int64_t>(ii) * 100}))
+            {
+                std::this_thread::yield();
+            }
+        }
+        ::_exit(0);
+    }
+
+    while (expected < transfers)
+    {
+        SharedNode<Transfer> *node = header->pop_forward();
+
+        if (node == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_EQ(expected, node->data().id);
+        EXPECT_EQ(static_cast<std::int64_t>(expected) * 100, node->data().cents);
+        header->deallocate(node);
+        expected++;
+    }
+    ASSERT_EQ(child, ::waitpid(child, &status, 0));
+    SharedMemory::unlink(name);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    EXPECT_TRUE(header->isEmpty());
+}
+
+TEST(TestSharedQueue, UnlinkWhenMapFails)
+{
+    std::string name = "/StaxSharedQueue.MapFails." + std::to_string(::getpid());
+
+    //
+    // A zero length object can be created but not mapped.  It must not be left behind to block the next create.
+    //
+    EXPECT_THROW(SharedMemory(name, 0), std::system_error);
+    EXPECT_THROW(SharedMemory{name}, std::system_error);
+
+    SharedMemory region(name, SharedQueueHead<Transfer>::regionSize(4));
+
+    SharedMemory::unlink(name);
+    EXPECT_NE(nullptr, SharedQueueHead<Transfer>::create(region.address(), region.size()));
+}
+
+//
+// Return a path, unique to this process, for the files of a PersistentQueueHead.
+//
+static std::string
+persistentPath(const std::string &name)
+{
+    std::string path = testing::TempDir() + "StaxPersistentQueue." + name + "." + std::to_string(::getpid());
+
+    PersistentQueueHead<Transfer>::remove(path);
+    return path;
+}
+
+TEST(TestPersistentQueue, ReopenAfterClose)
+{
+    std::string path = persistentPath("Reopen");
+
+    {
+        PersistentQueueHead<Transfer> header(path, 8);
+        PersistentNode<Transfer> *node = nullptr;
+
+        EXPECT_TRUE(header.isEmpty());
+        EXPECT_EQ(8, header.capacity());
+        for (std::uint64_t ii = 1; ii <= 5; ii++)
+        {
+            EXPECT_TRUE(header.emplace_backward(Transfer{ii, static_cast<std::int64_t>(ii) * 100}));
+        }
+        node = header.allocate();
+        node->data() = Transfer{0, 0};
+        header.push_forward(node);
+        node = header.pop_backward();
+        EXPECT_EQ(5, node->data().id);
+        header.deallocate(node);
+        node = header.pop_forward();
+        EXPECT_EQ(0, node->data().id);
+        header.deallocate(node);
+        EXPECT_EQ(4, header.size());
+    }
+
+    //
+    // The journal has pops in it, so recovery rewrites it as one 16 byte push record per node.
+    //
+    std::uintmax_t journalBytes = 0;
+    {
+        PersistentQueueHead<Transfer> header(path, 8);
+
+        journalBytes = std::filesystem::file_size(path + ".journal");
+        EXPECT_EQ(4, header.size());
+        for (std::uint64_t ii = 1; ii <= 2; ii++)
+        {
+            PersistentNode<Transfer> *node = header.pop_forward();
+
+            EXPECT_EQ(ii, node->data().id);
+            EXPECT_EQ(static_cast<std::int64_t>(ii) * 100, node->data().cents);
+            header.deallocate(node);
+        }
+    }
+    EXPECT_EQ(4 * 16, journalBytes);
+    {
+        PersistentQueueHead<Transfer> header(path, 8);
+
+        EXPECT_EQ(2, header.size());
+        EXPECT_EQ(3, header.pop_forward()->data().id);
+        EXPECT_EQ(4, header.pop_forward()->data().id);
+        EXPECT_TRUE(header.isEmpty());
+    }
+    EXPECT_THROW(PersistentQueueHead<Transfer>(path, 16), std::runtime_error);
+    EXPECT_THROW(PersistentQueueHead<int>(path, 8), std::runtime_error);
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+TEST(TestPersistentQueue, Crash)
+{
+    std::string path = persistentPath("Crash");
+    int status = 0;
+
+    //
+    // The child commits 10 pushes and a pop, then dies without committing 5 more pushes and another pop.
+    //
+    pid_t child = ::fork();
+
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        PersistentQueueHead<Transfer> header(path, 32, 1000);
+
+        for (std::uint64_t ii = 0; ii < 10; ii++)
+        {
+            header.emplace_backward(Transfer{ii, 0});
+        }
+        header.deallocate(header.pop_forward());
+        header.commit();
+        for (std::uint64_t ii = 10; ii < 15; ii++)
+        {
+            header.emplace_backward(Transfer{ii, 0});
+        }
+        header.pop_forward();
+        ::_exit(0);
+    }
+    ASSERT_EQ(child, ::waitpid(child, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+
+    PersistentQueueHead<Transfer> header(path, 32);
+
+    ASSERT_EQ(9, header.size());
+    for (std::uint64_t ii = 1; ii < 10; ii++)
+    {
+        EXPECT_EQ(ii, header.pop_forward()->data().id);
+    }
+    EXPECT_TRUE(header.isEmpty());
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+TEST(TestPersistentQueue, TornJournal)
+{
+    std::string path = persistentPath("Torn");
+
+    {
+        PersistentQueueHead<Transfer> header(path, 4);
+
+        header.emplace_backward(Transfer{1, 100});
+        header.emplace_backward(Transfer{2, 200});
+    }
+    {
+        std::ofstream journal(path + ".journal", std::ios::binary | std::ios::app);
+
+        journal.write("\x03\0\0\0garbage-garbage-", 20);
+    }
+    {
+        PersistentQueueHead<Transfer> header(path, 4);
+
+        EXPECT_EQ(2 * 16, std::filesystem::file_size(path + ".journal"));
+        EXPECT_EQ(2, header.size());
+        EXPECT_EQ(1, header.pop_forward()->data().id);
+        EXPECT_EQ(2, header.pop_forward()->data().id);
+    }
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+TEST(TestPersistentQueue, ReuseAfterCommit)
+{
+    std::string path = persistentPath("Reuse");
+    PersistentQueueHead<Transfer> header(path, 1, 100);
+    PersistentNode<Transfer> *node = nullptr;
+
+    EXPECT_TRUE(header.emplace_backward(Transfer{1, 100}));
+    node = header.pop_forward();
+    header.deallocate(node);
+
+    //
+    // The only node cannot be reused until its pop is durable.
+    //
+    EXPECT_EQ(nullptr, header.allocate());
+    header.commit();
+    EXPECT_EQ(node, header.allocate());
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+TEST(TestPersistentQueue, ReuseEveryCommit)
+{
+    std::string path = persistentPath("ReuseEvery");
+    PersistentQueueHead<Transfer> header(path, 1, 1);
+
+    //
+    // With a group commit size of one, each pop is durable before the node is deallocated.
+    //
+    for (std::uint64_t ii = 0; ii < 3; ii++)
+    {
+        EXPECT_TRUE(header.emplace_backward(Transfer{ii, 100}));
+
+        PersistentNode<Transfer> *node = header.pop_forward();
+
+        ASSERT_NE(nullptr, node);
+        header.deallocate(node);
+        header.commit();
+    }
+    EXPECT_NE(nullptr, header.allocate());
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+TEST(TestPersistentQueue, ReuseAtGroupBoundary)
+{
+    std::string path = persistentPath("ReuseBoundary");
+    PersistentQueueHead<Transfer> header(path, 2, 2);
+
+    //
+    // The push and the pop fill a group of two, so the pop is committed before the node is deallocated.
+    //
+    EXPECT_TRUE(header.emplace_backward(Transfer{1, 100}));
+
+    PersistentNode<Transfer> *node = header.pop_forward();
+
+    header.deallocate(node);
+    EXPECT_EQ(node, header.allocate());
+    header.deallocate(node);
+    EXPECT_TRUE(header.emplace_backward(Transfer{2, 200}));
+    EXPECT_TRUE(header.emplace_backward(Transfer{3, 300}));
+    EXPECT_EQ(nullptr, header.allocate());
+    PersistentQueueHead<Transfer>::remove(path);
+}
+
+//
+// A payment that records when it was added to an instrumented queue.
+//
+struct TimedPayment
+{
+    std::uint64_t id;
+    std::uint64_t enqueueTime;
+};
+
+static_assert(Timestamped<TimedPayment>);
+static_assert(!Timestamped<int>);
+static_assert(sizeof(QueueHead<int>) == sizeof(QueueHead<int, LatencyInstrumentation<>>));
+static_assert(sizeof(QueueHead<int>) == sizeof(Node<int>) + 2 * sizeof(std::size_t));
+
+TEST(TestInstrumentation, Histogram)
+{
+    DwellHistogram histogram;
+
+    for (std::uint64_t value : {std::uint64_t(0), std::uint64_t(63), std::uint64_t(64), std::uint64_t(1000000),
+                                ~std::uint64_t(0)})
+    {
+        std::size_t bucket = DwellHistogram::index(value);
+
+        EXPECT_LT(bucket, DwellHistogram::bucketCount);
+        EXPECT_GE(DwellHistogram::highestEquivalent(bucket), value);
+        if (bucket > 0)
+        {
+            EXPECT_LT(DwellHistogram::highestEquivalent(bucket - 1), value);
+        }
+    }
+    EXPECT_EQ(0, histogram.percentile(0.5));
+    for (std::uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(1000, histogram.count());
+    EXPECT_NEAR(500000, histogram.percentile(0.5), 500000 / 32);
+    EXPECT_NEAR(990000, histogram.percentile(0.99), 990000 / 32);
+    EXPECT_NEAR(999000, histogram.percentile(0.999), 999000 / 32);
+    EXPECT_NEAR(1000000, histogram.percentile(1.0), 1000000 / 32);
+}
+
+TEST(TestInstrumentation, DwellTime)
+{
+    struct Tag {};
+    using Instrumented = QueueHead<TimedPayment, LatencyInstrumentation<Tag>>;
+    Instrumented header;
+    Node<TimedPayment> first(TimedPayment{1, 0});
+    Node<TimedPayment> second(TimedPayment{2, 0});
+    Node<TimedPayment> third(TimedPayment{3, 0});
+
+    header.push_backward(&first);
+    header.push_backward(&second);
+    header.push_forward(&third);
+    EXPECT_NE(0, first.data().enqueueTime);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    while (!header.isEmpty())
+    {
+        header.pop_forward();
+    }
+
+    QueueStats::Snapshot snapshot = LatencyInstrumentation<Tag>::stats().snapshot();
+
+    EXPECT_EQ(3, snapshot.pushes);
+    EXPECT_EQ(3, snapshot.pops);
+    EXPECT_EQ(0, snapshot.steals);
+    EXPECT_EQ(3, snapshot.highWater);
+    EXPECT_EQ(3, snapshot.samples);
+    EXPECT_GE(snapshot.p50, 2000000);
+    EXPECT_GE(snapshot.p999, snapshot.p99);
+    EXPECT_GE(snapshot.p99, snapshot.p50);
+}
+
+TEST(TestInstrumentation, CountsOnly)
+{
+    struct Tag {};
+    QueueHead<int, LatencyInstrumentation<Tag>> header;
+    Node<int> nodes[4];
+
+    for (Node<int> &node : nodes)
+    {
+        header.insert(header.end(), &node);
+    }
+    header.erase(header.begin());
+    header.pop_backward();
+
+    QueueStats::Snapshot snapshot = LatencyInstrumentation<Tag>::stats().snapshot();
+
+    EXPECT_EQ(4, snapshot.pushes);
+    EXPECT_EQ(2, snapshot.pops);
+    EXPECT_EQ(4, snapshot.highWater);
+    EXPECT_EQ(0, snapshot.samples);
+    EXPECT_EQ(0, snapshot.p50);
+}
+
+TEST(TestInstrumentation, Steals)
+{
+    struct Tag {};
+    ShardedQueue<TimedPayment, LatencyInstrumentation<Tag>> header(2);
+    std::vector<Node<TimedPayment>> nodes(8);
+
+    for (Node<TimedPayment> &node : nodes)
+    {
+        header.push_backward(0, &node);
+    }
+    EXPECT_NE(nullptr, header.pop_backward(1));
+
+    QueueStats::Snapshot snapshot = LatencyInstrumentation<Tag>::stats().snapshot();
+
+    EXPECT_EQ(8, snapshot.pushes);
+    EXPECT_EQ(1, snapshot.pops);
+    EXPECT_EQ(4, snapshot.steals);
+    EXPECT_EQ(8, snapshot.highWater);
+    EXPECT_EQ(1, snapshot.samples);
+}
+
+TEST(TestInstrumentation, SnapshotWhileRunning)
+{
+    struct Tag {};
+    constexpr int threads = 4;
+    constexpr int iterations = 20000;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> workers;
+
+    for (int ii = 0; ii < threads; ii++)
+    {
+        workers.emplace_back([]()
+        {
+            QueueHead<TimedPayment, LatencyInstrumentation<Tag>> header;
+            Node<TimedPayment> node;
+
+            for (int jj = 0; jj < iterations; jj++)
+            {
+                header.push_backward(&node);
+                header.pop_forward();
+            }
+        });
+    }
+
+    std::thread exporter([&done]()
+    {
+        std::uint64_t pops = 0;
+
+        while (!done.load())
+        {
+            QueueStats::Snapshot snapshot = LatencyInstrumentation<Tag>::stats().snapshot();
+
+            EXPECT_GE(snapshot.pops, pops);
+            pops = snapshot.pops;
+        }
+    });
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    done.store(true);
+    exporter.join();
+
+    QueueStats::Snapshot snapshot = LatencyInstrumentation<Tag>::stats().snapshot();
+
+    EXPECT_EQ(threads * iterations, snapshot.pushes);
+    EXPECT_EQ(threads * iterations, snapshot.pops);
+    EXPECT_EQ(threads * iterations, snapshot.samples);
+    EXPECT_EQ(1, snapshot.highWater);
+}
+
+static_assert(std::bidirectional_iterator<ChunkedQueueHead<int>::iterator>);
+static_assert(std::bidirectional_iterator<ChunkedQueueHead<int>::const_iterator>);
+static_assert(std::ranges::bidirectional_range<ChunkedQueueHead<int>>);
+static_assert(std::ranges::bidirectional_range<const ChunkedQueueHead<int>>);
+static_assert(ChunkedQueueHead<int, 64>::chunkBytes() % ChunkedQueueHead<int>::cacheLine == 0);
+static_assert(ChunkedQueueHead<int, 64>::chunkBytes() / 64 < sizeof(Node<int>));
+
+TEST(TestChunkedQueue, PushPopBothEnds)
+{
+    ChunkedQueueHead<int, 4> header;
+    int data = 0;
+
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_FALSE(header.pop_forward(data));
+    EXPECT_FALSE(header.pop_backward(data));
+    EXPECT_EQ(header.begin(), header.end());
+    for (int ii = 0; ii < 6; ii++)
+    {
+        header.push_backward(ii);
+    }
+    for (int ii = -1; ii > -6; ii--)
+    {
+        header.push_forward(ii);
+    }
+    EXPECT_EQ(11, header.size());
+    EXPECT_EQ(4, header.chunkCount());
+    EXPECT_EQ(-5, header.front());
+    EXPECT_EQ(5, header.back());
+    EXPECT_EQ(std::vector<int>({-5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5}), std::vector<int>(header.begin(), header.end()));
+    EXPECT_EQ(std::vector<int>({5, 4, 3, 2, 1, 0, -1, -2, -3, -4, -5}),
+              std::vector<int>(header.rbegin(), header.rend()));
+
+    for (int expected = -5; expected < 0; expected++)
+    {
+        EXPECT_TRUE(header.pop_forward(data));
+        EXPECT_EQ(expected, data);
+    }
+    for (int expected = 5; expected >= 0; expected--)
+    {
+        EXPECT_TRUE(header.pop_backward(data));
+        EXPECT_EQ(expected, data);
+    }
+    EXPECT_TRUE(header.isEmpty());
+    EXPECT_EQ(0, header.chunkCount());
+    EXPECT_EQ(header.begin(), header.end());
+}
+
+TEST(TestChunkedQueue, MatchesDeque)
+{
+    ChunkedQueueHead<std::string, 3> header;
+    std::deque<std::string> expected;
+    std::mt19937 random(12345);
+    std::string data;
+
+    for (int ii = 0; ii < 5000; ii++)
+    {
+        switch (random() % 4)
+        {
+            case 0:
+                header.emplace_forward(std::to_string(ii));
+                expected.push_front(std::to_string(ii));
+                break;
+
+            case 1:
+                header.push_backward(std::to_string(ii));
+                expected.push_back(std::to_string(ii));
+                break;
+
+            case 2:
+                EXPECT_EQ(!expected.empty(), header.pop_forward(data));
+                if (!expected.empty())
+                {
+                    EXPECT_EQ(expected.front(), data);
+                    expected.pop_front();
+                }
+                break;
+
+            default:
+                EXPECT_EQ(!expected.empty(), header.pop_backward(data));
+                if (!expected.empty())
+                {
+                    EXPECT_EQ(expected.back(), data);
+                    expected.pop_back();
+                }
+                break;
+        }
+    }
+    EXPECT_EQ(expected.size(), header.size());
+    EXPECT_TRUE(std::ranges::equal(expected, header));
+    EXPECT_TRUE(std::ranges::equal(expected | std::views::reverse, header | std::views::reverse));
+
+    //
+    // The destructor destroys the strings still in the queue.
+    //
+    header.push_backward(std::string(100, 'x'));
+}
+
+TEST(TestChunkedQueue, OverAligned)
+{
+    struct alignas(1024) Wide
+    {
+        int value;
+    };
+    ChunkedQueueHead<Wide, 2> header;
+
+    for (int ii = 0; ii < 9; ii++)
+    {
+        Wide &item = header.emplace_backward(ii);
+
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(&item) % alignof(Wide));
+    }
+    EXPECT_EQ(5, header.chunkCount());
+    EXPECT_EQ(8, header.back().value);
+}
+
+TEST(TestChunkedQueue, Iterate)
+{
+    ChunkedQueueHead<int, 8> header;
+    const ChunkedQueueHead<int, 8> &constHeader = header;
+
+    for (int ii = 0; ii < 100; ii++)
+    {
+        header.push_backward(ii);
+    }
+    for (int &data : header)
+    {
+        data *= 2;
+    }
+    EXPECT_EQ(2 * 4950, std::accumulate(constHeader.begin(), constHeader.end(), 0));
+
+    ChunkedQueueHead<int, 8>::const_iterator found = std::find(constHeader.begin(), constHeader.end(), 100);
+
+    ASSERT_NE(constHeader.end(), found);
+    EXPECT_EQ(98, *std::prev(found));
+    EXPECT_EQ(102, *std::next(found));
+    EXPECT_EQ(198, *std::prev(header.end()));
+    EXPECT_EQ(100, std::distance(header.cbegin(), header.cend()));
+}
+
+struct Timer
+{
+    int id;                     //!< Identifies the timer.
+    std::uint64_t deadline;     //!< The tick at which the timer expires.
+};
+
+static_assert(HasDeadline<Timer>);
+static_assert(!HasDeadline<int>);
+
+TEST(TestTimingWheel, ExpireAcrossLevels)
+{
+    TimingWheel<Timer, 2, 4> wheel;
+    QueueHead<Timer> expired;
+    const std::uint64_t deadlines[] = {3, 1, 15, 16, 17, 255, 256, 1000, 3};
+    Node<Timer> nodes[std::size(deadlines)];
+
+    for (std::size_t ii = 0; ii < std::size(deadlines); ii++)
+    {
+        nodes[ii].data().id = static_cast<int>(ii);
+        wheel.schedule(&nodes[ii], deadlines[ii]);
+    }
+    EXPECT_EQ(9, wheel.size());
+    EXPECT_EQ(0, wheel.advance(0, expired));
+    EXPECT_EQ(1, wheel.advance(1, expired));
+    EXPECT_EQ(1, expired.pop_forward()->data().id);
+    EXPECT_EQ(0, wheel.advance(2, expired));
+    EXPECT_EQ(2, wheel.advance(3, expired));
+    EXPECT_EQ(0, expired.pop_forward()->data().id);
+    EXPECT_EQ(8, expired.pop_forward()->data().id);
+
+    //
+    // One call covering two levels returns the nodes in order of deadline.
+    //
+    EXPECT_EQ(5, wheel.advance(300, expired));
+    EXPECT_EQ(300, wheel.now());
+    EXPECT_EQ(5, expired.size());
+    for (std::uint64_t deadline : {15, 16, 17, 255, 256})
+    {
+        EXPECT_EQ(deadline, expired.pop_forward()->data().deadline);
+    }
+    EXPECT_EQ(0, wheel.advance(999, expired));
+    EXPECT_EQ(1, wheel.advance(1000, expired));
+    EXPECT_EQ(7, expired.pop_forward()->data().id);
+    EXPECT_TRUE(wheel.isEmpty());
+    EXPECT_EQ(0, wheel.advance(5000, expired));
+
+    //
+    // A deadline already passed is returned by the next advance, even without moving time forward.
+    //
+    wheel.schedule(&nodes[7], 10);
+    EXPECT_EQ(1, wheel.size());
+    EXPECT_EQ(1, wheel.advance(5000, expired));
+    EXPECT_TRUE(wheel.isEmpty());
+    EXPECT_EQ(&nodes[7], expired.pop_forward());
+}
+
+TEST(TestTimingWheel, AlreadyDueInScheduleOrder)
+{
+    TimingWheel<Timer, 2, 4> wheel(100);
+    QueueHead<Timer> expired;
+    Node<Timer> nodes[4];
+
+    //
+    // Deadlines already passed come first, in the order they were scheduled, then the rest by deadline.
+    //
+    wheel.schedule(&nodes[0], 102);
+    wheel.schedule(&nodes[1], 90);
+    wheel.schedule(&nodes[2], 101);
+    wheel.schedule(&nodes[3], 50);
+    EXPECT_EQ(4, wheel.advance(102, expired));
+    EXPECT_EQ(&nodes[1], expired.pop_forward());
+    EXPECT_EQ(&nodes[3], expired.pop_forward());
+    EXPECT_EQ(&nodes[2], expired.pop_forward());
+    EXPECT_EQ(&nodes[0], expired.pop_forward());
+}
+
+TEST(TestTimingWheel, Cancel)
+{
+    TimingWheel<Timer, 2, 4> wheel(100);
+    QueueHead<Timer> expired;
+    Node<Timer> nodes[4];
+
+    wheel.schedule(&nodes[0], 105);
+    wheel.schedule(&nodes[1], 105);
+    wheel.schedule(&nodes[2], 200);
+    wheel.schedule(&nodes[3], 100000);
+    wheel.cancel(&nodes[1]);
+    wheel.cancel(&nodes[3]);
+    EXPECT_EQ(2, wheel.size());
+
+    //
+    // A node moved down a level can still be cancelled.
+    //
+    EXPECT_EQ(1, wheel.advance(192, expired));
+    EXPECT_EQ(&nodes[0], expired.pop_forward());
+    wheel.cancel(&nodes[2]);
+    EXPECT_TRUE(wheel.isEmpty());
+    EXPECT_EQ(0, wheel.advance(1000000, expired));
+
+    //
+    // A cancelled node can be scheduled again.
+    //
+    wheel.schedule(&nodes[1], 1000001);
+    EXPECT_EQ(1, wheel.advance(1000001, expired));
+    EXPECT_EQ(&nodes[1], expired.pop_forward());
+}
+
+TEST(TestTimingWheel, MatchesSortedDeadlines)
+{
+    TimingWheel<Timer, 3, 3> wheel(7);
+    QueueHead<Timer> expired;
+    std::vector<Node<Timer>> nodes(2000);
+    std::vector<bool> scheduled(nodes.size(), false);
+    std::mt19937_64 random(4242);
+    std::uint64_t now = 7;
+
+    for (std::size_t ii = 0; ii < nodes.size(); ii++)
+    {
+        nodes[ii].data().id = static_cast<int>(ii);
+    }
+    for (int round = 0; round < 400; round++)
+    {
+        for (int ii = 0; ii < 10; ii++)
+        {
+            std::size_t which = random() % nodes.size();
+            std::uint64_t range = std::uint64_t(1) << (random() % 14);
+
+            if (scheduled[which])
+            {
+                wheel.cancel(&nodes[which]);
+            }
+            wheel.schedule(&nodes[which], now + (random() % range));
+            scheduled[which] = true;
+        }
+        now += random() % 300;
+
+        std::vector<std::uint64_t> expected;
+
+        for (std::size_t ii = 0; ii < nodes.size(); ii++)
+        {
+            if (scheduled[ii] && (nodes[ii].data().deadline <= now))
+            {
+                expected.push_back(nodes[ii].data().deadline);
+                scheduled[ii] = false;
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(expected.size(), wheel.advance(now, expired));
+        ASSERT_EQ(expected.size(), expired.size());
+
+        std::vector<std::uint64_t> actual;
+
+        while (!expired.isEmpty())
+        {
+            actual.push_back(expired.pop_forward()->data().deadline);
+        }
+        ASSERT_EQ(expected, actual);
+        ASSERT_EQ(std::count(scheduled.begin(), scheduled.end(), true), wheel.size());
+    }
+}
+
+TEST(TestTimingWheel, LargeJump)
+{
+    TimingWheel<Timer> wheel;
+    QueueHead<Timer> expired;
+    Node<Timer> nodes[3];
+
+    wheel.schedule(&nodes[0], std::uint64_t(1) << 40);
+    wheel.schedule(&nodes[1], (std::uint64_t(1) << 40) + 1);
+    wheel.schedule(&nodes[2], 12);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(2, wheel.advance(std::uint64_t(1) << 40, expired));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_EQ(&nodes[2], expired.pop_forward());
+    EXPECT_EQ(&nodes[0], expired.pop_forward());
+    EXPECT_EQ(1, wheel.advance(~std::uint64_t(0), expired));
+    EXPECT_EQ(&nodes[1], expired.pop_forward());
+}
+
 int
 main(int argc, char** argv)
 {